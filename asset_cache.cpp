@@ -0,0 +1,73 @@
+#include "maze_game.h"
+
+AssetCache& AssetCache::instance() {
+    static AssetCache cache;
+    return cache;
+}
+
+void AssetCache::set_root(const std::string& dir) {
+    root = dir;
+    // ȥĩβķָresolveʱͳһһ
+    while (root.size() > 1 && (root.back() == '/' || root.back() == '\\')) {
+        root.pop_back();
+    }
+}
+
+const std::string& AssetCache::get_root() const { return root; }
+
+std::string AssetCache::resolve(const std::string& name) const {
+    return root + "/" + name;
+}
+
+Texture2D AssetCache::acquire_texture(const std::string& name) {
+    return acquire_texture(name, [this, &name] { return LoadImage(resolve(name).c_str()); });
+}
+
+Texture2D AssetCache::acquire_texture(const std::string& name, const std::function<Image()>& build) {
+    auto it = textures.find(name);
+    if (it != textures.end()) {
+        ++it->second.refs;
+        ++stats.hits;
+        return it->second.texture;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    Image img = build();
+    Texture2D texture = LoadTextureFromImage(img);
+    UnloadImage(img);
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+    ++stats.loads;
+    stats.load_ms += elapsed.count();
+    TraceLog(LOG_INFO, "ASSET: %s loaded in %.2f ms", name.c_str(), elapsed.count());
+    textures[name] = Entry{ texture, 1 };
+    return texture;
+}
+
+void AssetCache::release_texture(const std::string& name) {
+    auto it = textures.find(name);
+    if (it != textures.end() && it->second.refs > 0) {
+        --it->second.refs;
+    }
+}
+
+void AssetCache::unload_unused() {
+    for (auto it = textures.begin(); it != textures.end();) {
+        if (it->second.refs == 0) {
+            UnloadTexture(it->second.texture);
+            it = textures.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+void AssetCache::unload_all() {
+    for (auto& pair : textures) {
+        UnloadTexture(pair.second.texture);
+    }
+    textures.clear();
+}
+
+const AssetStats& AssetCache::get_stats() const { return stats; }
@@ -0,0 +1,47 @@
+﻿#include "bench_alloc.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// 替换operator new/delete，在每块前放一个头记录大小，以便统计当前与峰值占用
+namespace {
+std::atomic<uint64_t> alloc_count{ 0 };
+std::atomic<size_t> live_bytes{ 0 };
+std::atomic<size_t> peak_bytes{ 0 };
+
+// 块头按最大对齐放置，其后即为返回给调用方的内存
+struct alignas(std::max_align_t) AllocHeader {
+    size_t size;
+};
+}
+
+void* operator new(size_t size) {
+    AllocHeader* header = static_cast<AllocHeader*>(std::malloc(sizeof(AllocHeader) + size));
+    if (!header) throw std::bad_alloc();
+    header->size = size;
+    alloc_count.fetch_add(1, std::memory_order_relaxed);
+    size_t live = live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+    size_t peak = peak_bytes.load(std::memory_order_relaxed);
+    while (live > peak && !peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+    return header + 1;
+}
+
+void operator delete(void* ptr) noexcept {
+    if (!ptr) return;
+    AllocHeader* header = static_cast<AllocHeader*>(ptr) - 1;
+    live_bytes.fetch_sub(header->size, std::memory_order_relaxed);
+    std::free(header);
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete[](void* ptr) noexcept { operator delete(ptr); }
+void operator delete(void* ptr, size_t) noexcept { operator delete(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { operator delete(ptr); }
+
+uint64_t get_alloc_count() { return alloc_count.load(); }
+
+size_t get_live_heap() { return live_bytes.load(); }
+
+size_t get_peak_heap() { return peak_bytes.load(); }
+
+void reset_peak_heap() { peak_bytes.store(live_bytes.load()); }
@@ -0,0 +1,21 @@
+﻿#ifndef BENCH_ALLOC_H
+#define BENCH_ALLOC_H
+
+// maze_bench的全局分配计数：bench_alloc.cpp替换operator new/delete，
+// 单独编译，调用处看不到分配函数体，编译器不会把块头运算内联进来误报越界
+#include <cstddef>
+#include <cstdint>
+
+// 累计分配次数
+uint64_t get_alloc_count();
+
+// 当前堆占用（字节）
+size_t get_live_heap();
+
+// 上次reset_peak_heap以来的堆占用峰值（字节）
+size_t get_peak_heap();
+
+// 把峰值重置为当前占用
+void reset_peak_heap();
+
+#endif // BENCH_ALLOC_H
@@ -0,0 +1,34 @@
+#ifndef BIT_GRID_H
+#define BIT_GRID_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// BitGridдλͼÿռwords_per_row64λ֣xλڵx/64ֵĵx%64λ
+class BitGrid {
+private:
+    int rows = 0;
+    int cols = 0;
+    int words_per_row = 0;
+    std::vector<uint64_t> words;
+
+public:
+    BitGrid() = default;
+    BitGrid(int rows_, int cols_)
+        : rows(rows_), cols(cols_), words_per_row((cols_ + 63) / 64),
+          words(static_cast<size_t>(rows_) * ((cols_ + 63) / 64), 0) {}
+
+    int get_rows() const { return rows; }
+    int get_cols() const { return cols; }
+    int get_words_per_row() const { return words_per_row; }
+
+    size_t word_index(int y, int w) const { return static_cast<size_t>(y) * words_per_row + w; }
+    uint64_t& word(size_t index) { return words[index]; }
+    uint64_t word(size_t index) const { return words[index]; }
+
+    bool test(int x, int y) const { return (words[word_index(y, x / 64)] >> (x % 64)) & 1; }
+    void set(int x, int y) { words[word_index(y, x / 64)] |= uint64_t(1) << (x % 64); }
+};
+
+#endif // BIT_GRID_H
@@ -0,0 +1,117 @@
+#include "chunk_store.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+ChunkedTileStore::ChunkedTileStore(const std::string& filepath, size_t budget_bytes_)
+    : file(filepath, std::ios::binary), budget_bytes(budget_bytes_) {
+    if (!file.is_open()) {
+        std::cerr << "Failed to open maze file!" << std::endl;
+        return;
+    }
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || std::memcmp(header.magic, MAZE_FILE_MAGIC, sizeof(header.magic)) != 0
+        || header.version != MAZE_FILE_VERSION || header.encoding != MAZE_ENCODING_CHUNKED
+        || header.chunk_shift == 0 || header.chunk_shift > 12 || header.rows <= 0 || header.cols <= 0) {
+        std::cerr << "Invalid chunked maze file!" << std::endl;
+        return;
+    }
+
+    chunk_shift = header.chunk_shift;
+    chunk_size = 1 << chunk_shift;
+    chunks_x = (header.cols + chunk_size - 1) / chunk_size;
+    chunks_y = (header.rows + chunk_size - 1) / chunk_size;
+    chunk_bytes = static_cast<size_t>(chunk_size) * chunk_size;
+    stats.budget_bytes = budget_bytes;
+
+    // ļȲʱֱӾܾϷ;ضϵĿ
+    file.seekg(0, std::ios::end);
+    size_t expected = sizeof(header) + chunk_bytes * chunks_x * chunks_y;
+    if (static_cast<size_t>(file.tellg()) < expected) {
+        std::cerr << "Chunked maze file truncated!" << std::endl;
+        return;
+    }
+    opened = true;
+}
+
+ChunkedTileStore::Chunk& ChunkedTileStore::fetch(size_t id) const {
+    auto it = index.find(id);
+    if (it != index.end()) {
+        ++stats.hits;
+        lru.splice(lru.begin(), lru, it->second);
+        return lru.front();
+    }
+
+    ++stats.misses;
+    // Ԥʱӱβ̭δõĿ飨޸ĹĿ鲻̭
+    auto victim = lru.end();
+    while (stats.resident_bytes + chunk_bytes > budget_bytes && victim != lru.begin()) {
+        --victim;
+        if (victim->dirty) continue;
+        if (victim->id == last_id) {
+            last_id = SIZE_MAX;
+            last_data = nullptr;
+        }
+        index.erase(victim->id);
+        victim = lru.erase(victim);
+        stats.resident_bytes -= chunk_bytes;
+        ++stats.evictions;
+    }
+
+    lru.push_front(Chunk{ id, std::vector<uint8_t>(chunk_bytes), false });
+    Chunk& chunk = lru.front();
+    file.clear();
+    file.seekg(static_cast<std::streamoff>(sizeof(header) + chunk_bytes * id));
+    file.read(reinterpret_cast<char*>(chunk.data.data()), chunk_bytes);
+    if (!file) {
+        std::cerr << "Failed to read maze chunk " << id << std::endl;
+        std::fill(chunk.data.begin(), chunk.data.end(), static_cast<uint8_t>(1)); // ʧܰǽ
+    }
+    index[id] = lru.begin();
+    stats.resident_bytes += chunk_bytes;
+    return chunk;
+}
+
+uint8_t ChunkedTileStore::get(int x, int y) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t id = static_cast<size_t>(y >> chunk_shift) * chunks_x + (x >> chunk_shift);
+    size_t offset = (static_cast<size_t>(y & (chunk_size - 1)) << chunk_shift) + (x & (chunk_size - 1));
+    if (id == last_id) {
+        ++stats.hits;
+        return last_data[offset];
+    }
+    Chunk& chunk = fetch(id);
+    last_id = id;
+    last_data = chunk.data.data();
+    return last_data[offset];
+}
+
+void ChunkedTileStore::set(int x, int y, uint8_t value) {
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t id = static_cast<size_t>(y >> chunk_shift) * chunks_x + (x >> chunk_shift);
+    size_t offset = (static_cast<size_t>(y & (chunk_size - 1)) << chunk_shift) + (x & (chunk_size - 1));
+    Chunk& chunk = fetch(id);
+    chunk.dirty = true;
+    chunk.data[offset] = value;
+    last_id = id;
+    last_data = chunk.data.data();
+}
+
+void ChunkedTileStore::read_row(int y, int x0, int x1, uint8_t* out) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t row_offset = static_cast<size_t>(y & (chunk_size - 1)) << chunk_shift;
+    for (int x = x0; x < x1;) {
+        int cx = x >> chunk_shift;
+        int span = std::min(x1, (cx + 1) << chunk_shift) - x;
+        Chunk& chunk = fetch(static_cast<size_t>(y >> chunk_shift) * chunks_x + cx);
+        std::memcpy(out + (x - x0), chunk.data.data() + row_offset + (x & (chunk_size - 1)), span);
+        x += span;
+    }
+    last_id = SIZE_MAX; // fetch̭last_dataڵĿ
+    last_data = nullptr;
+}
+
+ChunkCacheStats ChunkedTileStore::get_stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
@@ -0,0 +1,73 @@
+#ifndef CHUNK_STORE_H
+#define CHUNK_STORE_H
+
+// ֿҳ洢ڴĴԹ̶СĿļУ
+// ʱ룬LRUڴԤ̭δõĿ
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "maze_format.h"
+
+// /ȱҳ/̭뵱ǰפֽ
+struct ChunkCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    size_t resident_bytes = 0;
+    size_t budget_bytes = 0;
+};
+
+// ChunkedTileStoreȡMAZE_ENCODING_CHUNKEDʽԹļ
+// ļаţԵ鲹ǽСһƫƿֱ
+// ޸ĹĿ鳣פڴ治̭дԭļsave_maze档
+// УļʱУ顣
+// ʼɹ̨߳߳ͬʱȡ
+class ChunkedTileStore {
+private:
+    struct Chunk {
+        size_t id;
+        std::vector<uint8_t> data;
+        bool dirty = false;
+    };
+
+    mutable std::ifstream file;
+    MazeFileHeader header = {};
+    int chunk_shift = 0;
+    int chunk_size = 0;
+    int chunks_x = 0;
+    int chunks_y = 0;
+    size_t chunk_bytes = 0;
+    size_t budget_bytes = 0;
+    bool opened = false;
+
+    mutable std::mutex mutex;
+    mutable std::list<Chunk> lru; // ͷΪʹ
+    mutable std::unordered_map<size_t, std::list<Chunk>::iterator> index;
+    mutable size_t last_id = SIZE_MAX;      // ʵĿ飬ͬһʱ
+    mutable uint8_t* last_data = nullptr;
+    mutable ChunkCacheStats stats;
+
+    // ȡ飨δפʱļ벢Ԥ̭÷
+    Chunk& fetch(size_t id) const;
+
+public:
+    ChunkedTileStore(const std::string& filepath, size_t budget_bytes_);
+
+    bool is_open() const { return opened; }
+    const MazeFileHeader& get_header() const { return header; }
+
+    uint8_t get(int x, int y) const;
+    void set(int x, int y, uint8_t value);
+
+    // ѵy[x0, x1)Ƶoutɨʱټ
+    void read_row(int y, int x0, int x1, uint8_t* out) const;
+
+    ChunkCacheStats get_stats() const;
+};
+
+#endif // CHUNK_STORE_H
@@ -0,0 +1,108 @@
+#include "incremental_planner.h"
+#include <algorithm>
+#include <cstdlib>
+
+IncrementalPlanner::IncrementalPlanner(int rows_, int cols_, std::vector<uint8_t> cell_cost_, size_t start_, size_t goal_, int min_cost_)
+    : rows(rows_), cols(cols_), start(start_), goal(goal_), min_cost(min_cost_), cell_cost(std::move(cell_cost_)),
+    g(cell_cost.size(), INF), rhs(cell_cost.size(), INF), on_path(cell_cost.size(), 0) {
+    // ʼʱֻ㲻һ£һreplanͬһA*
+    rhs[start] = 0;
+    open.push({ calculate_key(start), static_cast<uint32_t>(start) });
+}
+
+int IncrementalPlanner::heuristic(size_t idx) const {
+    int dx = std::abs(static_cast<int>(idx % cols) - static_cast<int>(goal % cols));
+    int dy = std::abs(static_cast<int>(idx / cols) - static_cast<int>(goal / cols));
+    return (dx + dy) * min_cost;
+}
+
+IncrementalPlanner::Key IncrementalPlanner::calculate_key(size_t idx) const {
+    int m = std::min(g[idx], rhs[idx]);
+    return { m >= INF ? INF : m + heuristic(idx), m };
+}
+
+void IncrementalPlanner::update_vertex(size_t idx) {
+    if (idx != start) {
+        int best = INF;
+        if (cell_cost[idx]) {
+            int step = cell_cost[idx];
+            for_each_neighbor(idx, [&](size_t n) {
+                if (cell_cost[n] && g[n] < INF) best = std::min(best, g[n] + step);
+            });
+        }
+        rhs[idx] = best;
+    }
+    if (g[idx] != rhs[idx]) {
+        open.push({ calculate_key(idx), static_cast<uint32_t>(idx) });
+    }
+}
+
+void IncrementalPlanner::set_cell_cost(size_t idx, uint8_t cost) {
+    if (cell_cost[idx] == cost) return;
+    cell_cost[idx] = cost;
+    if (on_path[idx]) path_dirty = true;
+
+    // øıߴ۱ˣøͨԱ뿪ıҲˣھһ
+    update_vertex(idx);
+    for_each_neighbor(idx, [this](size_t n) { update_vertex(n); });
+}
+
+ReplanResult IncrementalPlanner::replan(size_t max_expanded) {
+    expanded = 0;
+    converged = false;
+    while (!open.empty()) {
+        QueueEntry top = open.top();
+        if (g[goal] == rhs[goal] && !(top.key < calculate_key(goal))) break;
+        if (expanded >= max_expanded) return ReplanResult::BUDGET_EXCEEDED;
+        open.pop();
+
+        size_t u = top.idx;
+        if (g[u] == rhs[u] || !(top.key == calculate_key(u))) continue; // ɼ¼
+        ++expanded;
+        if (on_path[u] || u == goal) path_dirty = true; // ɴʱ·Ϊգյ۱仯ؽ
+
+        if (g[u] > rhs[u]) {
+            // ½ͨǽȷgھӴ
+            g[u] = rhs[u];
+            for_each_neighbor(u, [this](size_t n) { update_vertex(n); });
+        }
+        else {
+            // סͨ·Ϊͬھrhs
+            g[u] = INF;
+            update_vertex(u);
+            for_each_neighbor(u, [this](size_t n) { update_vertex(n); });
+        }
+    }
+    converged = true;
+    if (!path_dirty) return ReplanResult::UNCHANGED;
+
+    for (size_t idx : path) on_path[idx] = 0;
+    path.clear();
+    path_dirty = false;
+    if (g[goal] >= INF) return ReplanResult::CHANGED;
+
+    // ·ϵĸreplanһ£ÿȡg+Сǰ
+    size_t curr = goal;
+    path.push_back(curr);
+    while (curr != start && path.size() <= cell_cost.size()) {
+        size_t best = curr;
+        int best_cost = INF;
+        for_each_neighbor(curr, [&](size_t n) {
+            if (cell_cost[n] && g[n] < best_cost) {
+                best_cost = g[n];
+                best = n;
+            }
+        });
+        if (best == curr) {
+            path.clear();
+            return ReplanResult::CHANGED;
+        }
+        curr = best;
+        path.push_back(curr);
+    }
+    std::reverse(path.begin(), path.end());
+    for (size_t idx : path) on_path[idx] = 1;
+    return ReplanResult::CHANGED;
+}
+
+int IncrementalPlanner::get_goal_cost() const { return !converged || g[goal] >= INF ? -1 : g[goal]; }
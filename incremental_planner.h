@@ -0,0 +1,94 @@
+#ifndef INCREMENTAL_PLANNER_H
+#define INCREMENTAL_PLANNER_H
+
+// Ѱ·LPA*ؿĶֻչӰĸ޸㵽յ·
+// MazeCoreÿ۸0ΪͨУ±Ϊ
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <queue>
+#include <vector>
+
+// replanĽ
+enum class ReplanResult {
+    UNCHANGED,      // ޸꣬·Ӱ
+    CHANGED,        // ޸꣬·ؽ
+    BUDGET_EXCEEDED // չﵽ޶ֹδĸڶУ´replan
+};
+
+class IncrementalPlanner {
+private:
+    static constexpr int INF = INT_MAX / 2; // g+۲
+
+    // ȼLPA*[min(g,rhs)+h; min(g,rhs)]ֵȽ
+    struct Key {
+        int k1, k2;
+        bool operator<(const Key& other) const { return k1 != other.k1 ? k1 < other.k1 : k2 < other.k2; }
+        bool operator==(const Key& other) const { return k1 == other.k1 && k2 == other.k2; }
+    };
+    struct QueueEntry {
+        Key key;
+        uint32_t idx;
+        bool operator>(const QueueEntry& other) const { return other.key < key; }
+    };
+
+    int rows = 0;
+    int cols = 0;
+    size_t start = 0;
+    size_t goal = 0;
+    int min_cost = 1; // ʽΪپСۣɲһ
+    std::vector<uint8_t> cell_cost;
+    std::vector<int> g;   // ϴչʱȷĴ
+    std::vector<int> rhs; // ǰgһǰհۣgȼΪһ¸
+    // ѣָ֧ļļ仯ʱֱӣʱ뵱ǰһµľɼ¼
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> open;
+    size_t expanded = 0;
+
+    // ǰ·ĸ޸չû·ϵĸʱ·Ȼţ»
+    std::vector<size_t> path;
+    std::vector<uint8_t> on_path;
+    bool path_dirty = true;
+    bool converged = false;
+
+    int heuristic(size_t idx) const;
+    Key calculate_key(size_t idx) const;
+
+    // ھӵgrhsһʱ
+    void update_vertex(size_t idx);
+
+    // εfidxĽھ
+    template <typename F>
+    void for_each_neighbor(size_t idx, F&& f) const {
+        int x = static_cast<int>(idx % cols);
+        int y = static_cast<int>(idx / cols);
+        if (y > 0) f(idx - cols);
+        if (y + 1 < rows) f(idx + cols);
+        if (x > 0) f(idx - 1);
+        if (x + 1 < cols) f(idx + 1);
+    }
+
+public:
+    // cell_cost_Ϊÿۣ0ΪͨУ㱾ƴ
+    IncrementalPlanner(int rows_, int cols_, std::vector<uint8_t> cell_cost_, size_t start_, size_t goal_, int min_cost_);
+
+    // ޸һĽֻۣѸøھӱΪ£´replanʱ޸
+    void set_cell_cost(size_t idx, uint8_t cost);
+
+    // չһµĸֱյȷ·Ӱʱյgؽ
+    // չmax_expanded񣬳ʱֹʱg·
+    ReplanResult replan(size_t max_expanded = SIZE_MAX);
+
+    // յۣɴʱΪ-1
+    int get_goal_cost() const;
+
+    // 㵽յĸ±꣨ˣɴʱΪ
+    const std::vector<size_t>& get_path() const { return path; }
+
+    // յǷȷһreplanδֹ
+    bool is_converged() const { return converged; }
+
+    // һreplanչĸ
+    size_t get_expanded() const { return expanded; }
+};
+
+#endif // INCREMENTAL_PLANNER_H
@@ -1,8 +1,36 @@
 ﻿#include "maze_game.h"
 #include <iostream>
 #include <vector>
+#include <atomic>
+#include <future>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+
+// 把结束的一局存为录像（replays/run_<时间戳>.mzr），可用maze_cli replay无窗口校验
+static void save_run_replay(ReplayLog& run, const Player& player) {
+    run.events = player.get_inputs();
+    run.result = player.get_result();
+    std::error_code ec;
+    std::filesystem::create_directories("replays", ec);
+    std::string path = "replays/run_" + std::to_string(std::time(nullptr)) + ".mzr";
+    if (save_replay(run, path)) {
+        TraceLog(LOG_INFO, "REPLAY: saved %s", path.c_str());
+    }
+}
+
+int main(int argc, char** argv) {
+    // 资源根目录：--assets <dir> 优先于环境变量MAZE_ASSET_ROOT，默认./assets
+    if (const char* env_root = std::getenv("MAZE_ASSET_ROOT")) {
+        AssetCache::instance().set_root(env_root);
+    }
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--assets") == 0 && i + 1 < argc) {
+            AssetCache::instance().set_root(argv[++i]);
+        }
+    }
 
-int main() {
     // 初始化窗口（可调整大小）
     InitWindow(1280, 720, "Maze Game");
     SetWindowState(FLAG_WINDOW_RESIZABLE);
@@ -13,14 +41,37 @@ int main() {
     GameOverOption selected_option = GameOverOption::REPLAY;
     std::unique_ptr<Maze> maze = nullptr;
     std::unique_ptr<Player> player = nullptr;
-    Timer game_timer;
+    ReplayLog current_run; // 本局迷宫来源，结束时连同输入记录存为录像
     int selected_difficulty = 0;
     const std::vector<std::pair<int, int>> difficulties = { {15, 15}, {25, 25}, {30, 30} }; // 迷宫难度
     std::string current_maze_path; // 自定义迷宫路径
     int current_random_size[2] = { 15, 15 }; // 随机迷宫尺寸
     Camera2D camera = { 0 };
+    bool show_debug = false; // F3切换绘制统计面板
+    FrameProfiler profiler;         // 逐帧分段计时
+    bool show_profiler = false;     // F4切换帧耗时面板，F5/F6导出CSV/Chrome trace
+    bool edit_mode = false;         // E键切换地块编辑模式，编辑期间玩家模拟暂停
+    uint32_t selected_seed = 1;                  // 随机迷宫种子，选择界面可调整
+    MazeCache maze_cache;                        // 随机迷宫按(尺寸, 种子)缓存到磁盘，重复请求直接读回（须先于任务声明）
+    std::atomic<float> loading_progress = 0.0f; // 后台生成进度（须先于任务声明，退出时任务先析构并等待线程结束）
+    std::future<MazeCore> loading_task;          // 后台生成任务（LOADING状态）
+    size_t cached_paths = 0;                     // 当前随机迷宫已存入缓存的路径数
 
     while (!WindowShouldClose()) {
+        profiler.begin_frame();
+        profiler.begin_phase(ProfilePhase::UPDATE);
+
+        // 帧耗时面板与导出（任何状态下可用）
+        if (IsKeyPressed(KEY_F4)) {
+            show_profiler = !show_profiler;
+        }
+        if (IsKeyPressed(KEY_F5) || IsKeyPressed(KEY_F6)) {
+            bool csv = IsKeyPressed(KEY_F5);
+            std::string path = "profile_" + std::to_string(std::time(nullptr)) + (csv ? ".csv" : ".json");
+            bool ok = csv ? profiler.export_csv(path) : profiler.export_chrome_trace(path);
+            TraceLog(ok ? LOG_INFO : LOG_WARNING, "PROFILER: %s %s", ok ? "exported" : "failed to export", path.c_str());
+        }
+
         // 全屏切换（F11）
         if (IsKeyPressed(KEY_F11)) {
             if (IsWindowFullscreen()) {
@@ -41,11 +92,11 @@ int main() {
         if (current_state == GameState::MENU) {
             if (IsKeyPressed(KEY_SPACE)) {
                 // 加载自定义迷宫
-                current_maze_path = "D:/数据结构/迷宫小游戏/1/assets/maze0.txt";
+                current_maze_path = AssetCache::instance().resolve("maze0.txt");
                 maze = std::make_unique<Maze>(current_maze_path);
                 player = std::make_unique<Player>(*maze);
-                game_timer.reset();
-                game_timer.start();
+                current_run = ReplayLog{};
+                current_run.maze_file = current_maze_path;
                 camera = init_camera(maze->get_cols(), maze->get_rows());
                 current_state = GameState::GAME_PLAYING;
             }
@@ -65,22 +116,48 @@ int main() {
             else if (IsKeyPressed(KEY_DOWN) || IsKeyPressed(KEY_S)) {
                 selected_difficulty = (selected_difficulty + 1) % difficulties.size();
             }
+            // 调整种子：左右键逐个切换，R键随机取一个
+            else if (IsKeyPressed(KEY_LEFT) || IsKeyPressed(KEY_A)) {
+                --selected_seed;
+            }
+            else if (IsKeyPressed(KEY_RIGHT) || IsKeyPressed(KEY_D)) {
+                ++selected_seed;
+            }
+            else if (IsKeyPressed(KEY_R)) {
+                selected_seed = std::random_device{}();
+            }
             else if (IsKeyPressed(KEY_ENTER)) {
-                // 生成选中难度的完美迷宫
+                // 在后台线程生成（或从缓存读回）选中难度的完美迷宫，窗口在LOADING状态下照常刷新
                 auto [rows, cols] = difficulties[selected_difficulty];
                 current_random_size[0] = rows;
                 current_random_size[1] = cols;
-                maze = std::make_unique<Maze>(rows, cols);
-                player = std::make_unique<Player>(*maze);
-                game_timer.reset();
-                game_timer.start();
-                camera = init_camera(maze->get_cols(), maze->get_rows());
-                current_state = GameState::GAME_PLAYING;
+                loading_progress = 0.0f;
+                uint32_t seed = selected_seed;
+                current_run = ReplayLog{};
+                current_run.rows = rows;
+                current_run.cols = cols;
+                current_run.seed = seed;
+                loading_task = std::async(std::launch::async, [rows, cols, seed, &loading_progress, &maze_cache] {
+                    return maze_cache.load_or_generate({ rows, cols, seed, 0 },
+                        [&loading_progress](float fraction) { loading_progress = fraction; });
+                });
+                current_state = GameState::LOADING;
             }
             else if (IsKeyPressed(KEY_ESCAPE)) {
                 current_state = GameState::MENU;
             }
         }
+        // 等待后台生成：完成后在主线程接管网格并上传纹理
+        else if (current_state == GameState::LOADING) {
+            if (loading_task.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+                maze = std::make_unique<Maze>(loading_task.get());
+                player = std::make_unique<Player>(*maze);
+                cached_paths = 0;
+                for (PathType type : MAZE_CACHE_PATHS) cached_paths += maze->is_path_ready(type);
+                camera = init_camera(maze->get_cols(), maze->get_rows());
+                current_state = GameState::GAME_PLAYING;
+            }
+        }
         // 游戏进行中
         else if (current_state == GameState::GAME_PLAYING) {
             // 相机控制：右键拖动视角
@@ -93,26 +170,66 @@ int main() {
             camera.zoom += ((float)GetMouseWheelMove() * 0.1f);
             camera.zoom = Clamp(camera.zoom, 0.2f, 2.0f); // 限制缩放范围
 
-            // 路径显示控制
+            if (IsKeyPressed(KEY_F3)) {
+                show_debug = !show_debug;
+            }
+
+            // 路径显示控制（按住Shift时叠加/取消叠加，用于对比不同算法）
+            const std::pair<int, PathType> path_keys[] = {
+                { KEY_ONE, PathType::DFS }, { KEY_TWO, PathType::BFS },
+                { KEY_THREE, PathType::DIJKSTRA }, { KEY_FOUR, PathType::ASTAR }
+            };
+            bool shift = IsKeyDown(KEY_LEFT_SHIFT) || IsKeyDown(KEY_RIGHT_SHIFT);
             if (IsKeyPressed(KEY_ZERO)) {
                 maze->set_current_path(PathType::NONE);
             }
-            else if (IsKeyPressed(KEY_ONE)) {
-                maze->set_current_path(PathType::DFS);
+            for (const auto& [key, type] : path_keys) {
+                if (!IsKeyPressed(key)) continue;
+                if (shift) maze->toggle_path(type);
+                else maze->set_current_path(type);
             }
-            else if (IsKeyPressed(KEY_TWO)) {
-                maze->set_current_path(PathType::BFS);
+            // 随机迷宫的路径在后台算完后补存进缓存，下次读回即可显示；改过地块后不再与种子对应，不存
+            if (current_run.maze_file.empty() && maze->get_edit_count() == 0) {
+                std::vector<PathType> ready;
+                for (PathType type : MAZE_CACHE_PATHS) {
+                    if (maze->is_path_ready(type)) ready.push_back(type);
+                }
+                if (ready.size() > cached_paths) {
+                    maze_cache.store_paths({ current_run.rows, current_run.cols, current_run.seed, 0 }, *maze, ready);
+                    cached_paths = ready.size();
+                }
             }
-            else if (IsKeyPressed(KEY_THREE)) {
-                maze->set_current_path(PathType::DIJKSTRA);
+
+            // 5键：从玩家当前位置到终点的最优路线提示
+            if (IsKeyPressed(KEY_FIVE)) {
+                maze->toggle_route_hint();
             }
 
-            // 玩家更新
-            if (!player->is_win_state() && !player->is_dead_state()) {
+            // E键切换地块编辑模式：编辑期间玩家模拟暂停（不计分、不计时、不记录输入），
+            // 左键在墙与地板间切换，按住Shift放置熔岩（玩家所在格不可改）
+            if (IsKeyPressed(KEY_E)) {
+                edit_mode = !edit_mode;
+            }
+            if (edit_mode && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
+                Coordinate c = maze->get_tile_coord(GetScreenToWorld2D(GetMousePosition(), camera));
+                if (!(c == player->get_coord())) {
+                    TileType curr = maze->get_edited_tile_type(c);
+                    TileType next = shift ? TileType::LAVA : (curr == TileType::WALL ? TileType::FLOOR : TileType::WALL);
+                    if (curr == next) next = TileType::FLOOR;
+                    maze->set_tile_type(c, next);
+                }
+            }
+
+            // 玩家更新（编辑模式下暂停）
+            bool playing = !player->is_win_state() && !player->is_dead_state();
+            if (playing && !edit_mode) {
+                FrameProfiler::Zone zone(profiler, ProfilePhase::PLAYER_UPDATE);
                 player->update();
+                maze->update_route_hint(player->get_coord());
             }
-            else {
-                game_timer.stop();
+            else if (!playing) {
+                // 改过地块的对局无法由录像中的迷宫来源复现，不保存
+                if (maze->get_edit_count() == 0) save_run_replay(current_run, *player);
                 current_state = GameState::GAME_OVER;
                 selected_option = GameOverOption::REPLAY;
             }
@@ -120,6 +237,7 @@ int main() {
             // 直接返回菜单（M键）
             if (IsKeyPressed(KEY_M)) {
                 current_state = GameState::MENU;
+                edit_mode = false;
                 maze.reset();
                 player.reset();
             }
@@ -138,8 +256,6 @@ int main() {
                 if (selected_option == GameOverOption::REPLAY) {
                     // 重玩当前迷宫
                     player->reset();
-                    game_timer.reset();
-                    game_timer.start();
                     current_state = GameState::GAME_PLAYING;
                 }
                 else if (selected_option == GameOverOption::MENU) {
@@ -159,6 +275,8 @@ int main() {
             }
         }
 
+        profiler.end_phase(ProfilePhase::UPDATE);
+
         // 绘制逻辑
         BeginDrawing();
         ClearBackground(RAYWHITE);
@@ -195,22 +313,68 @@ int main() {
                 }
             }
 
+            std::string seed_text = std::format("Seed: {}  (LEFT/RIGHT to change, R: random)", selected_seed);
+            DrawText(seed_text.c_str(), GetScreenWidth() / 2 - MeasureText(seed_text.c_str(), 20) / 2, 370, 20, BLACK);
             DrawText("Use arrow keys to select, ENTER to confirm", GetScreenWidth() / 2 - MeasureText("Use arrow keys to select, ENTER to confirm", 20) / 2, 400, 20, DARKGRAY);
             DrawText("Press ESC to go back | F11: Fullscreen", GetScreenWidth() / 2 - MeasureText("Press ESC to go back | F11: Fullscreen", 20) / 2, 430, 20, DARKGRAY);
         }
+        else if (current_state == GameState::LOADING) {
+            // 绘制生成进度条
+            std::string text = std::format("GENERATING {}x{} MAZE...", current_random_size[0], current_random_size[1]);
+            DrawText(text.c_str(), GetScreenWidth() / 2 - MeasureText(text.c_str(), 40) / 2, 200, 40, BLACK);
+
+            const int bar_width = 600;
+            const int bar_height = 30;
+            int bar_x = GetScreenWidth() / 2 - bar_width / 2;
+            float progress = loading_progress;
+            DrawRectangle(bar_x, 280, static_cast<int>(bar_width * progress), bar_height, DARKGREEN);
+            DrawRectangleLines(bar_x, 280, bar_width, bar_height, BLACK);
+
+            std::string percent = std::format("{:.0f}%", progress * 100.0f);
+            DrawText(percent.c_str(), GetScreenWidth() / 2 - MeasureText(percent.c_str(), 20) / 2, 320, 20, DARKGRAY);
+        }
         else if (current_state == GameState::GAME_PLAYING) {
             // 绘制游戏场景
-            maze->draw(camera);
-            player->draw(camera);
+            {
+                FrameProfiler::Zone zone(profiler, ProfilePhase::MAZE_DRAW);
+                maze->draw(camera);
+            }
+            {
+                FrameProfiler::Zone zone(profiler, ProfilePhase::PLAYER_DRAW);
+                player->draw(camera);
+            }
 
             // 绘制UI
+            FrameProfiler::Zone hud_zone(profiler, ProfilePhase::HUD);
             DrawText(std::format("FPS: {}", GetFPS()).c_str(), 5, 5, 20, BLACK);
             DrawText("Use arrow keys to move", 5, 25, 20, BLACK);
             DrawText(("Cost: " + std::to_string(player->get_score())).c_str(), 5, 45, 20, BLACK);
-            DrawText(("Time: " + std::format("{:.2f}s", game_timer.get_elapsed_time())).c_str(), 5, 65, 20, BLACK);
-            DrawText("0: Hide Path | 1: DFS | 2: BFS | 3: Dijkstra", 5, 85, 20, BLACK);
-            DrawText("Right Mouse: Drag View | Mouse Wheel: Zoom", 5, 105, 20, BLACK);
-            DrawText("F11: Fullscreen | M: Return to Menu", 5, 125, 20, BLACK);
+            DrawText(("Time: " + std::format("{:.2f}s", player->get_game_time())).c_str(), 5, 65, 20, BLACK);
+            DrawText("0: Hide Path | 1: DFS | 2: BFS | 3: Dijkstra | 4: A* | Shift+1~4: Overlay | 5: Route Hint", 5, 85, 20, BLACK);
+            DrawText("Right Mouse: Drag View | Mouse Wheel: Zoom | E: Editor", 5, 105, 20, BLACK);
+            DrawText("F11: Fullscreen | M: Return to Menu | F3: Debug | F4: Profiler", 5, 125, 20, BLACK);
+            if (edit_mode) {
+                DrawText("EDITOR (paused) - Left Click: Wall/Floor | Shift+Click: Lava | E: Resume", 5, 145, 20, RED);
+            }
+            else if (maze->get_edit_count() > 0) {
+                DrawText("Maze edited - this run is not recorded", 5, 145, 20, RED);
+            }
+
+            // 调试面板：上一帧地图绘制的调用数、批次数与静态层缓存
+            if (show_debug) {
+                const DrawStats& stats = maze->get_draw_stats();
+                int panel_x = GetScreenWidth() - 260;
+                const AssetStats& asset_stats = AssetCache::instance().get_stats();
+                MazeCacheStats cache_stats = maze_cache.get_stats();
+                DrawRectangle(panel_x, 0, 260, 161, Color{ 0, 0, 0, 160 });
+                DrawText(std::format("Draw calls: {}", stats.draw_calls).c_str(), panel_x + 10, 5, 20, WHITE);
+                DrawText(std::format("Batches: {}", stats.batches).c_str(), panel_x + 10, 27, 20, WHITE);
+                DrawText(std::format("Chunks cached: {}", stats.chunks_cached).c_str(), panel_x + 10, 49, 20, WHITE);
+                DrawText(std::format("Chunks rebuilt: {}", stats.chunks_rebuilt).c_str(), panel_x + 10, 71, 20, WHITE);
+                DrawText(std::format("Assets: {} loads {:.0f}ms", asset_stats.loads, asset_stats.load_ms).c_str(), panel_x + 10, 93, 20, WHITE);
+                DrawText(std::format("Maze cache: {:.0f}% hit", cache_stats.hit_rate() * 100.0).c_str(), panel_x + 10, 115, 20, WHITE);
+                DrawText(std::format("Load {:.1f}ms Gen {:.1f}ms", cache_stats.load_ms, cache_stats.generate_ms).c_str(), panel_x + 10, 137, 20, WHITE);
+            }
         }
         else if (current_state == GameState::GAME_OVER) {
             // 半透明遮罩
@@ -225,8 +389,8 @@ int main() {
             DrawText(("Total Cost: " + std::to_string(player->get_score())).c_str(),
                 GetScreenWidth() / 2 - MeasureText(("Total Cost: " + std::to_string(player->get_score())).c_str(), 30) / 2,
                 200, 30, WHITE);
-            DrawText(("Time: " + std::format("{:.2f}s", game_timer.get_elapsed_time())).c_str(),
-                GetScreenWidth() / 2 - MeasureText(("Time: " + std::format("{:.2f}s", game_timer.get_elapsed_time())).c_str(), 30) / 2,
+            DrawText(("Time: " + std::format("{:.2f}s", player->get_game_time())).c_str(),
+                GetScreenWidth() / 2 - MeasureText(("Time: " + std::format("{:.2f}s", player->get_game_time())).c_str(), 30) / 2,
                 240, 30, WHITE);
 
             // 结束选项
@@ -257,10 +421,22 @@ int main() {
             DrawText("ESC: Exit Game Directly", GetScreenWidth() / 2 - MeasureText("ESC: Exit Game Directly", 20) / 2, 480, 20, LIGHTGRAY);
         }
 
-        EndDrawing();
+        if (show_profiler) {
+            FrameProfiler::Zone zone(profiler, ProfilePhase::PROFILER);
+            profiler.draw_overlay(5, GetScreenHeight() - 290);
+        }
+
+        {
+            FrameProfiler::Zone zone(profiler, ProfilePhase::END_DRAWING);
+            EndDrawing();
+        }
+        profiler.end_frame();
     }
 
-    // 释放资源
+    // 释放资源（纹理须在关闭窗口前卸载）
+    player.reset();
+    maze.reset();
+    AssetCache::instance().unload_all();
     CloseWindow();
     return 0;
 }
\ No newline at end of file
@@ -1,434 +1,441 @@
 #include "maze_game.h"
-#include <fstream>
-#include <iostream>
-#include <cmath>
 #include <algorithm>
-#include <random>
-#include <utility>
+#include <cmath>
+#include "rlgl.h"
 
-bool Coordinate::operator==(const Coordinate& other) const {
-    return x == other.x && y == other.y;
-}
+// ͼԴе߼
+static const char* TILE_ATLAS_NAME = "tile_atlas";
 
-size_t std::hash<Coordinate>::operator()(const Coordinate& c) const {
-    return hash<int>()(c.x) ^ (hash<int>()(c.y) << 1);
+void Maze::load_textures() {
+    // ŵؿͼTileType˳ƴһͼʱʼհͬһraylibɺ
+    // ͼԴУٴιMazeʱֱӸ
+    const char* files[TILE_TYPE_COUNT] = { "end.png", "start.png", "floor.png", "wall.png", "grass.png", "lava.png" };
+    for (int i = 0; i < TILE_TYPE_COUNT; ++i) {
+        tile_src[i] = { static_cast<float>(i * TILE_WIDTH), 0, static_cast<float>(TILE_WIDTH), static_cast<float>(TILE_HEIGHT) };
+    }
+    atlas = AssetCache::instance().acquire_texture(TILE_ATLAS_NAME, [this, &files] {
+        Image atlas_img = GenImageColor(TILE_WIDTH * TILE_TYPE_COUNT, TILE_HEIGHT, BLANK);
+        for (int i = 0; i < TILE_TYPE_COUNT; ++i) {
+            Image img = LoadImage(AssetCache::instance().resolve(files[i]).c_str());
+            ImageDraw(&atlas_img, img, { 0, 0, static_cast<float>(img.width), static_cast<float>(img.height) }, tile_src[i], WHITE);
+            UnloadImage(img);
+        }
+        return atlas_img;
+    });
+    overlay_material = LoadMaterialDefault();
 }
 
-bool Maze::is_valid(Coordinate c) const {
-    return c.x >= 0 && c.x < cols && c.y >= 0 && c.y < rows
-        && get_tile_type(c) != TileType::WALL
-        && get_tile_type(c) != TileType::LAVA;
+Maze::Maze(const std::string& filepath) : MazeCore(filepath) {
+    load_textures();
 }
 
-std::vector<Coordinate> Maze::get_neighbors(Coordinate c) const {
-    std::vector<Coordinate> neighbors;
-    if (is_valid({ c.x, c.y - 1 })) neighbors.push_back({ c.x, c.y - 1 }); // 
-    if (is_valid({ c.x, c.y + 1 })) neighbors.push_back({ c.x, c.y + 1 }); // 
-    if (is_valid({ c.x - 1, c.y })) neighbors.push_back({ c.x - 1, c.y }); // 
-    if (is_valid({ c.x + 1, c.y })) neighbors.push_back({ c.x + 1, c.y }); // 
-    return neighbors;
+Maze::Maze(int rows, int cols) : MazeCore(rows, cols) {
+    load_textures();
 }
 
-bool Maze::validate_maze_path() {
-    std::vector<std::vector<bool>> visited(rows, std::vector<bool>(cols, false));
-    std::queue<Coordinate> q;
-    q.push(start_coord);
-    visited[start_coord.y][start_coord.x] = true;
+Maze::Maze(MazeCore&& core) : MazeCore(std::move(core)) {
+    load_textures();
 
-    while (!q.empty()) {
-        Coordinate curr = q.front();
-        q.pop();
+    // Ѵ·Ӵ̻أΪ꣬ʾʱ̨
+    for (PathType type : { PathType::DFS, PathType::BFS, PathType::DIJKSTRA, PathType::ASTAR,
+        PathType::BIDIRECTIONAL_BFS, PathType::BIDIRECTIONAL_DIJKSTRA }) {
+        if (!has_path(type)) continue;
+        std::promise<void> done;
+        done.set_value();
+        path_tasks[type] = done.get_future();
+    }
+}
 
-        if (curr == end_coord) return true;
+Maze::~Maze() {
+    // ȴڽеĺ̨֮ͷԹ
+    for (auto& pair : path_tasks) {
+        pair.second.wait();
+    }
+    for (auto& task : retired_tasks) {
+        task.wait();
+    }
+    if (exit_field_task.valid()) exit_field_task.wait();
 
-        for (auto& neighbor : get_neighbors(curr)) {
-            if (!visited[neighbor.y][neighbor.x]) {
-                visited[neighbor.y][neighbor.x] = true;
-                q.push(neighbor);
-            }
-        }
+    // ͷ붥㻺
+    for (auto& pair : layer_chunks) {
+        UnloadRenderTexture(pair.second.target);
     }
-    return false;
+    AssetCache::instance().release_texture(TILE_ATLAS_NAME);
+    path_overlays.clear();
+    hint_overlay.clear();
+    UnloadMaterial(overlay_material);
 }
 
-void Maze::compute_dfs_path() {
-    std::vector<std::vector<bool>> visited(rows, std::vector<bool>(cols, false));
-    std::stack<std::pair<Coordinate, std::vector<Coordinate>>> s;
-    s.push({ start_coord, {start_coord} });
+void Maze::request_path(PathType type) {
+    if (type == PathType::NONE || path_tasks.count(type)) return; // Ѽڼ
 
-    while (!s.empty()) {
-        auto [curr, path] = s.top();
-        s.pop();
+    uint64_t generation = get_grid_generation();
+    path_tasks[type] = std::async(std::launch::async, [this, type, generation] {
+        std::lock_guard<std::mutex> lock(solver_mutex);
+        if (get_grid_generation() != generation) return; // Ŷڼؿ޸ģ
+        compute_path(type);
+    });
+}
 
-        if (curr == end_coord) {
-            dfs_path = path;
-            return;
-        }
-        if (visited[curr.y][curr.x]) continue;
-        visited[curr.y][curr.x] = true;
-
-        auto neighbors = get_neighbors(curr);
-        std::reverse(neighbors.begin(), neighbors.end());
-        for (auto& neighbor : neighbors) {
-            if (!visited[neighbor.y][neighbor.x]) {
-                std::vector<Coordinate> new_path = path;
-                new_path.push_back(neighbor);
-                s.push({ neighbor, new_path });
-            }
-        }
+void Maze::set_current_path(PathType type) {
+    shown_paths.clear();
+    if (type == PathType::NONE) return;
+    shown_paths.push_back(type);
+    request_path(type);
+}
+
+void Maze::toggle_path(PathType type) {
+    if (type == PathType::NONE) return;
+    auto it = std::find(shown_paths.begin(), shown_paths.end(), type);
+    if (it != shown_paths.end()) {
+        shown_paths.erase(it);
+        return;
     }
+    shown_paths.push_back(type);
+    request_path(type);
 }
 
-void Maze::compute_bfs_path() {
-    std::vector<std::vector<bool>> visited(rows, std::vector<bool>(cols, false));
-    std::vector<std::vector<Coordinate>> prev(rows, std::vector<Coordinate>(cols, { -1, -1 }));
-    std::queue<Coordinate> q;
+void Maze::toggle_route_hint() {
+    show_route_hint = !show_route_hint;
+    if (show_route_hint) request_exit_field();
+}
 
-    q.push(start_coord);
-    visited[start_coord.y][start_coord.x] = true;
+void Maze::request_exit_field() {
+    if (exit_field_task.valid()) return; // ڼ
 
-    while (!q.empty()) {
-        Coordinate curr = q.front();
-        q.pop();
+    uint64_t generation = get_grid_generation();
+    exit_field_task = std::async(std::launch::async, [this, generation] {
+        std::lock_guard<std::mutex> lock(solver_mutex);
+        if (get_grid_generation() != generation) return;
+        compute_exit_field();
+    });
+}
 
-        if (curr == end_coord) break;
+bool Maze::is_exit_field_ready() const {
+    return exit_field_task.valid() &&
+        exit_field_task.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
 
-        for (auto& neighbor : get_neighbors(curr)) {
-            if (!visited[neighbor.y][neighbor.x]) {
-                visited[neighbor.y][neighbor.x] = true;
-                prev[neighbor.y][neighbor.x] = curr;
-                q.push(neighbor);
-            }
-        }
-    }
+void Maze::update_route_hint(Coordinate from) {
+    if (!show_route_hint || !is_exit_field_ready()) return;
+    if (from.x == hint_from.x && from.y == hint_from.y) return;
 
-    // ·
-    Coordinate curr = end_coord;
-    while (curr.x != -1 && curr.y != -1) {
-        bfs_path.push_back(curr);
-        curr = prev[curr.y][curr.x];
-    }
-    std::reverse(bfs_path.begin(), bfs_path.end());
+    hint_from = from;
+    hint_overlay.clear();
+    build_overlay(route_to_exit(from), hint_overlay);
 }
 
-int Maze::get_tile_cost(TileType type) const {
-    return (type == TileType::GRASS) ? 3 : 1;
+bool Maze::is_path_ready(PathType type) const {
+    if (type == PathType::NONE) return true;
+    auto it = path_tasks.find(type);
+    return it != path_tasks.end() &&
+        it->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
 }
 
-void Maze::compute_dijkstra_path() {
-    const int INF = INT_MAX;
-    std::vector<std::vector<int>> dist(rows, std::vector<int>(cols, INF));
-    std::vector<std::vector<Coordinate>> prev(rows, std::vector<Coordinate>(cols, { -1, -1 }));
-    using PriorityNode = std::tuple<int, int, int>;
-    std::priority_queue<PriorityNode, std::vector<PriorityNode>, std::greater<>> pq;
-
-    dist[start_coord.y][start_coord.x] = 0;
-    pq.emplace(0, start_coord.x, start_coord.y);
-
-    while (!pq.empty()) {
-        auto [cost, x, y] = pq.top();
-        pq.pop();
-        Coordinate curr = { x, y };
-
-        if (curr == end_coord) break;
-        if (cost > dist[y][x]) continue;
-
-        for (auto& neighbor : get_neighbors(curr)) {
-            int nx = neighbor.x, ny = neighbor.y;
-            int new_cost = cost + get_tile_cost(get_tile_type(neighbor));
-            if (new_cost < dist[ny][nx]) {
-                dist[ny][nx] = new_cost;
-                prev[ny][nx] = curr;
-                pq.emplace(new_cost, nx, ny);
-            }
-        }
-    }
-
-    // ·
-    Coordinate curr = end_coord;
-    while (curr.x != -1 && curr.y != -1) {
-        dijkstra_path.push_back(curr);
-        curr = prev[curr.y][curr.x];
+// ·ıɫ͸ʱɿغϲ֣
+static Color path_color(PathType type) {
+    switch (type) {
+    case PathType::DFS: return Color{ 255, 0, 0, 150 };        // ɫ
+    case PathType::BFS: return Color{ 0, 0, 255, 150 };        // ɫ
+    case PathType::DIJKSTRA: return Color{ 0, 255, 0, 150 };   // ɫ
+    case PathType::ASTAR: return Color{ 255, 165, 0, 150 };    // ɫ
+    case PathType::BIDIRECTIONAL_BFS: return Color{ 128, 0, 255, 150 };      // ɫ
+    case PathType::BIDIRECTIONAL_DIJKSTRA: return Color{ 0, 200, 200, 150 }; // ɫ
+    default: return BLANK; // NONE
     }
-    std::reverse(dijkstra_path.begin(), dijkstra_path.end());
 }
 
-void Maze::load_textures() {
-    // еؿ
-    Image img_end = LoadImage("D:/ݽṹ/ԹСϷ/1/assets/end.png");
-    textures[TileType::END] = LoadTextureFromImage(img_end);
-    UnloadImage(img_end);
-
-    Image img_start = LoadImage("D:/ݽṹ/ԹСϷ/1/assets/start.png");
-    textures[TileType::START] = LoadTextureFromImage(img_start);
-    UnloadImage(img_start);
-
-    Image img_floor = LoadImage("D:/ݽṹ/ԹСϷ/1/assets/floor.png");
-    textures[TileType::FLOOR] = LoadTextureFromImage(img_floor);
-    UnloadImage(img_floor);
-
-    Image img_wall = LoadImage("D:/ݽṹ/ԹСϷ/1/assets/wall.png");
-    textures[TileType::WALL] = LoadTextureFromImage(img_wall);
-    UnloadImage(img_wall);
-
-    Image img_grass = LoadImage("D:/ݽṹ/ԹСϷ/1/assets/grass.png");
-    textures[TileType::GRASS] = LoadTextureFromImage(img_grass);
-    UnloadImage(img_grass);
-
-    Image img_lava = LoadImage("D:/ݽṹ/ԹСϷ/1/assets/lava.png");
-    textures[TileType::LAVA] = LoadTextureFromImage(img_lava);
-    UnloadImage(img_lava);
+const Maze::PathOverlay& Maze::get_path_overlay(PathType type) {
+    auto it = path_overlays.find(type);
+    if (it != path_overlays.end()) return it->second;
+
+    PathOverlay& overlay = path_overlays[type];
+    build_overlay(get_path(type), overlay);
+    return overlay;
 }
 
-void Maze::load_maze(const std::string& filepath) {
-    std::ifstream file(filepath);
-    if (!file.is_open()) {
-        std::cerr << "Failed to open maze file!" << std::endl;
-        return;
+void Maze::PathOverlay::clear() {
+    for (auto& pair : buckets) {
+        UnloadMesh(pair.second);
     }
+    buckets.clear();
+}
 
-    file >> rows >> cols;
-    tiles.resize(rows, std::vector<Tile>(cols));
-
-    for (int r = 0; r < rows; ++r) {
-        for (int c = 0; c < cols; ++c) {
-            int tile_val;
-            file >> tile_val;
+void Maze::build_overlay(const std::vector<Coordinate>& path, PathOverlay& overlay) const {
+    // Ȱռ㣬ϴÿΣraylibƾεһ£ʱ룩
+    std::unordered_map<size_t, std::vector<float>> vertices;
+    for (const auto& c : path) {
+        Vector2 pos = get_tile_position(c);
+        float x0 = pos.x + TILE_WIDTH / 2 - 8;
+        float y0 = pos.y + TILE_HEIGHT / 2 - 8;
+        float x1 = x0 + 16;
+        float y1 = y0 + 16;
+        auto& bucket = vertices[layer_chunk_id(c.x / LAYER_CHUNK_TILES, c.y / LAYER_CHUNK_TILES)];
+        bucket.insert(bucket.end(), {
+            x0, y0, 0, x0, y1, 0, x1, y1, 0,
+            x0, y0, 0, x1, y1, 0, x1, y0, 0
+        });
+    }
 
-            TileType type = static_cast<TileType>(tile_val);
-            tiles[r][c].type = type;
-            tiles[r][c].position = {
-                static_cast<float>(c * TILE_WIDTH),
-                static_cast<float>(r * TILE_HEIGHT)
-            };
+    for (auto& [id, bucket] : vertices) {
+        Mesh mesh = {};
+        mesh.vertexCount = static_cast<int>(bucket.size() / 3);
+        mesh.triangleCount = mesh.vertexCount / 3;
+        mesh.vertices = static_cast<float*>(MemAlloc(static_cast<unsigned int>(bucket.size() * sizeof(float))));
+        std::copy(bucket.begin(), bucket.end(), mesh.vertices);
+        UploadMesh(&mesh, false);
+        // ԴУڴ渱Ҫ
+        MemFree(mesh.vertices);
+        mesh.vertices = nullptr;
+        overlay.buckets.emplace(id, mesh);
+    }
+}
 
-            if (type == TileType::START) {
-                start_coord = { c, r };
-            }
-            else if (type == TileType::END) {
-                end_coord = { c, r };
-            }
+int Maze::draw_overlay(const PathOverlay& overlay, Color color, float offset, const TileRange& visible_chunks) {
+    overlay_material.maps[MATERIAL_MAP_DIFFUSE].color = color;
+    Matrix transform = MatrixTranslate(offset, offset, 0);
+    int meshes = 0;
+    for (int cy = visible_chunks.y0; cy < visible_chunks.y1; ++cy) {
+        for (int cx = visible_chunks.x0; cx < visible_chunks.x1; ++cx) {
+            auto it = overlay.buckets.find(layer_chunk_id(cx, cy));
+            if (it == overlay.buckets.end()) continue;
+            DrawMesh(it->second, overlay_material, transform);
+            ++meshes;
         }
     }
-    file.close();
+    return meshes;
+}
 
-    // ¼·
-    compute_dfs_path();
-    compute_bfs_path();
-    compute_dijkstra_path();
+TileRange Maze::get_visible_range(const Camera2D& camera) const {
+    float w = static_cast<float>(GetScreenWidth());
+    float h = static_cast<float>(GetScreenHeight());
+    Vector2 corners[4] = {
+        GetScreenToWorld2D({ 0, 0 }, camera),
+        GetScreenToWorld2D({ w, 0 }, camera),
+        GetScreenToWorld2D({ 0, h }, camera),
+        GetScreenToWorld2D({ w, h }, camera)
+    };
+    float min_x = corners[0].x, max_x = corners[0].x;
+    float min_y = corners[0].y, max_y = corners[0].y;
+    for (const Vector2& c : corners) {
+        min_x = std::min(min_x, c.x);
+        max_x = std::max(max_x, c.x);
+        min_y = std::min(min_y, c.y);
+        max_y = std::max(max_y, c.y);
+    }
+
+    // Եȡһ񣬱ⲿֿɼĵؿ鱻õ
+    TileRange range;
+    range.x0 = std::clamp(static_cast<int>(std::floor(min_x / TILE_WIDTH)) - 1, 0, cols);
+    range.y0 = std::clamp(static_cast<int>(std::floor(min_y / TILE_HEIGHT)) - 1, 0, rows);
+    range.x1 = std::clamp(static_cast<int>(std::floor(max_x / TILE_WIDTH)) + 2, 0, cols);
+    range.y1 = std::clamp(static_cast<int>(std::floor(max_y / TILE_HEIGHT)) + 2, 0, rows);
+    return range;
 }
 
-void Maze::generate_random_maze(int rows_, int cols_) {
-    // 1. ǿԹߴΪ
-    rows = (rows_ % 2 == 0) ? rows_ + 1 : rows_;
-    cols = (cols_ % 2 == 0) ? cols_ + 1 : cols_;
-    tiles.resize(rows, std::vector<Tile>(cols));
-
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dir_dist(0, 3); // 
-    std::uniform_int_distribution<> type_dist(0, 19); // ؿ͸
-
-    // 2. ʼλΪǽ
-    for (int y = 0; y < rows; ++y) {
-        for (int x = 0; x < cols; ++x) {
-            tiles[y][x].type = TileType::WALL;
-            tiles[y][x].position = {
-                static_cast<float>(x * TILE_WIDTH),
-                static_cast<float>(y * TILE_HEIGHT)
-            };
+void Maze::draw_tiles(const TileRange& range, Vector2 origin) {
+    for (int y = range.y0; y < range.y1; ++y) {
+        for (int x = range.x0; x < range.x1; ++x) {
+            Vector2 pos = { origin.x + (x - range.x0) * TILE_WIDTH, origin.y + (y - range.y0) * TILE_HEIGHT };
+            DrawTextureRec(atlas, tile_source(tile_at(x, y)), pos, WHITE);
         }
     }
+}
 
-    // 3. ԪṹԪ(2i+1,2j+1)ǽżλ
-    using Cell = std::pair<int, int>;
-    std::vector<std::vector<bool>> visited((rows - 1) / 2, std::vector<bool>((cols - 1) / 2, false));
-    std::stack<Cell> stack;
-
-    // 㵥Ԫ񣨶ӦԹ(1,1)
-    Cell start_cell = { 0, 0 };
-    stack.push(start_cell);
-    visited[start_cell.first][start_cell.second] = true;
-    int visited_cells = 1;
-    int total_cells = ((rows - 1) / 2) * ((cols - 1) / 2); // ܵԪ
-
-    // 4. DFSԹ
-    while (visited_cells < total_cells) {
-        Cell curr = stack.top();
-        int i = curr.first;
-        int j = curr.second;
-        std::vector<std::pair<Cell, Cell>> neighbors;
-
-        // ھ
-        if (i > 0 && !visited[i - 1][j]) {
-            neighbors.push_back({ {i - 1, j}, {2 * i, 2 * j + 1} });
-        }
-        // ھ
-        if (i < (rows - 1) / 2 - 1 && !visited[i + 1][j]) {
-            neighbors.push_back({ {i + 1, j}, {2 * (i + 1), 2 * j + 1} });
-        }
-        // ھ
-        if (j > 0 && !visited[i][j - 1]) {
-            neighbors.push_back({ {i, j - 1}, {2 * i + 1, 2 * j} });
-        }
-        // ھ
-        if (j < (cols - 1) / 2 - 1 && !visited[i][j + 1]) {
-            neighbors.push_back({ {i, j + 1}, {2 * i + 1, 2 * (j + 1)} });
+const Maze::LayerChunk& Maze::get_layer_chunk(int cx, int cy, const TileRange& visible_chunks) {
+    size_t id = layer_chunk_id(cx, cy);
+    TileRange range = {
+        cx * LAYER_CHUNK_TILES, cy * LAYER_CHUNK_TILES,
+        std::min(cols, (cx + 1) * LAYER_CHUNK_TILES), std::min(rows, (cy + 1) * LAYER_CHUNK_TILES)
+    };
+
+    auto it = layer_chunks.find(id);
+    if (it == layer_chunks.end()) {
+        // ʱ̭һǰɼĿ飨ɼޣҵ
+        if (layer_chunks.size() >= MAX_LAYER_CHUNKS) {
+            int chunks_x = layer_chunks_x();
+            for (auto victim = layer_chunks.begin(); victim != layer_chunks.end(); ++victim) {
+                Coordinate c = { static_cast<int>(victim->first % chunks_x), static_cast<int>(victim->first / chunks_x) };
+                if (!visible_chunks.contains(c)) {
+                    UnloadRenderTexture(victim->second.target);
+                    layer_chunks.erase(victim);
+                    break;
+                }
+            }
         }
+        RenderTexture2D target = LoadRenderTexture((range.x1 - range.x0) * TILE_WIDTH, (range.y1 - range.y0) * TILE_HEIGHT);
+        it = layer_chunks.emplace(id, LayerChunk{ target, true }).first;
+    }
 
-        if (!neighbors.empty()) {
-            // ѡھ
-            auto [next_cell, wall_pos] = neighbors[dir_dist(gen) % neighbors.size()];
-            int wall_x = wall_pos.second;
-            int wall_y = wall_pos.first;
-            int cell_x = 2 * next_cell.second + 1;
-            int cell_y = 2 * next_cell.first + 1;
-
-            // ͨǽΪذ壩
-            tiles[wall_y][wall_x].type = TileType::FLOOR;
-            // Ŀ굥ԪΪذ
-            tiles[cell_y][cell_x].type = TileType::FLOOR;
-
-            // һԪ
-            visited[next_cell.first][next_cell.second] = true;
-            stack.push(next_cell);
-            visited_cells++;
-        }
-        else {
-            stack.pop();
-        }
+    LayerChunk& chunk = it->second;
+    if (chunk.dirty) {
+        BeginTextureMode(chunk.target);
+        ClearBackground(BLANK);
+        draw_tiles(range, { 0, 0 });
+        EndTextureMode();
+        chunk.dirty = false;
+        ++draw_stats.chunks_rebuilt;
     }
+    return chunk;
+}
 
-    // 5. յ
-    start_coord = { 1, 1 };
-    tiles[start_coord.y][start_coord.x].type = TileType::START;
-    end_coord = { cols - 2, rows - 2 };
-    tiles[end_coord.y][end_coord.x].type = TileType::END;
-
-    // 6. Ӳݵ/
-    std::vector<Coordinate> all_floors;
-    for (int y = 1; y < rows - 1; y += 2) { // Ԫλ
-        for (int x = 1; x < cols - 1; x += 2) {
-            Coordinate c = { x, y };
-            if (tiles[y][x].type == TileType::FLOOR) {
-                all_floors.push_back(c);
+void Maze::invalidate_tile(Coordinate c) {
+    auto it = layer_chunks.find(layer_chunk_id(c.x / LAYER_CHUNK_TILES, c.y / LAYER_CHUNK_TILES));
+    if (it != layer_chunks.end()) it->second.dirty = true;
+}
+
+void Maze::draw(const Camera2D& camera) {
+    apply_pending_edits(); // һ֡߳æݴ޸
+
+    TileRange visible = get_visible_range(camera);
+    TileRange visible_chunks = {
+        visible.x0 / LAYER_CHUNK_TILES, visible.y0 / LAYER_CHUNK_TILES,
+        (visible.x1 + LAYER_CHUNK_TILES - 1) / LAYER_CHUNK_TILES, (visible.y1 + LAYER_CHUNK_TILES - 1) / LAYER_CHUNK_TILES
+    };
+    int chunk_count = (visible_chunks.x1 - visible_chunks.x0) * (visible_chunks.y1 - visible_chunks.y0);
+    bool use_layer = chunk_count <= MAX_LAYER_CHUNKS;
+    draw_stats = DrawStats{};
+
+    // ȾBeginMode2D֮ǰػ
+    std::vector<std::pair<const LayerChunk*, Vector2>> chunks;
+    if (use_layer) {
+        for (int cy = visible_chunks.y0; cy < visible_chunks.y1; ++cy) {
+            for (int cx = visible_chunks.x0; cx < visible_chunks.x1; ++cx) {
+                chunks.emplace_back(&get_layer_chunk(cx, cy, visible_chunks),
+                    get_tile_position({ cx * LAYER_CHUNK_TILES, cy * LAYER_CHUNK_TILES }));
             }
         }
     }
 
-    // ޸ĵذΪݵ/
-    std::shuffle(all_floors.begin(), all_floors.end(), gen);
-    int modify_count = std::min((int)all_floors.size() / 3, 30);
-    for (int i = 0; i < modify_count; ++i) {
-        Coordinate c = all_floors[i];
-        int rand_type = type_dist(gen);
-        if (rand_type < 15) { // 75% ݵ
-            tiles[c.y][c.x].type = TileType::GRASS;
-        }
-        else if (rand_type < 18) { // 15% ֵذ
-            tiles[c.y][c.x].type = TileType::FLOOR;
+    BeginMode2D(camera);
+    if (use_layer) {
+        // ÿһλƣȾµߵԴθ߶ȡ
+        for (const auto& [chunk, pos] : chunks) {
+            const Texture2D& tex = chunk->target.texture;
+            DrawTextureRec(tex, { 0, 0, static_cast<float>(tex.width), -static_cast<float>(tex.height) }, pos, WHITE);
         }
-        else { // 10% 
-            tiles[c.y][c.x].type = TileType::LAVA;
+        draw_stats.draw_calls += static_cast<int>(chunks.size());
+        draw_stats.batches += static_cast<int>(chunks.size());
+    }
+    else {
+        // ɼ̫ʱֱӰͼƿɼؿ飬ֻһΪһ
+        draw_tiles(visible, get_tile_position({ visible.x0, visible.y0 }));
+        draw_stats.draw_calls += (visible.x1 - visible.x0) * (visible.y1 - visible.y0);
+        draw_stats.batches += 1;
+    }
+    draw_stats.chunks_cached = static_cast<int>(layer_chunks.size());
+
+    // ѡе·̨δʱ㴦ʾбǣ
+    // ԴУÿɼͰһDrawMeshDrawMeshraylib
+    // ύŶӵĵؿ飬֤ǻڵؿ֮ϡӶʱԴأȫغ
+    rlDrawRenderBatchActive();
+    int overlays = 0;
+    bool computing = false;
+    for (size_t slot = 0; slot < shown_paths.size(); ++slot) {
+        PathType type = shown_paths[slot];
+        if (!is_path_ready(type)) {
+            computing = true;
+            continue;
         }
+        const PathOverlay& overlay = get_path_overlay(type);
+        Color color = path_color(type);
+        float offset = (static_cast<float>(slot) - (shown_paths.size() - 1) / 2.0f) * 6.0f;
+        overlays += draw_overlay(overlay, color, offset, visible_chunks);
     }
 
-    // 7. У·Чԣ޸
-    while (!validate_maze_path()) {
-        // ҵҸΪذ
-        for (int y = 1; y < rows - 1; ++y) {
-            for (int x = 1; x < cols - 1; ++x) {
-                if (tiles[y][x].type == TileType::LAVA) {
-                    tiles[y][x].type = TileType::FLOOR;
-                    if (validate_maze_path()) break;
-                }
-            }
-            if (validate_maze_path()) break;
+    // ·ʾûɫǣ󻭣·֮
+    if (show_route_hint) {
+        if (!is_exit_field_ready()) {
+            computing = true;
+        }
+        else if (!hint_overlay.buckets.empty()) {
+            overlays += draw_overlay(hint_overlay, Color{ 255, 230, 0, 200 }, 0, visible_chunks);
         }
     }
+    draw_stats.draw_calls += overlays;
+    draw_stats.batches += overlays;
 
-    // 8. ¼·
-    compute_dfs_path();
-    compute_bfs_path();
-    compute_dijkstra_path();
-}
-
-Maze::Maze(const std::string& filepath) {
-    load_textures();
-    load_maze(filepath);
-}
-
-Maze::Maze(int rows, int cols) {
-    load_textures();
-    generate_random_maze(rows, cols);
+    if (computing) {
+        Vector2 pos = get_tile_position(start_coord);
+        DrawText("Computing...", static_cast<int>(pos.x), static_cast<int>(pos.y - 20), 20, DARKGRAY);
+    }
+    EndMode2D();
 }
 
-Maze::~Maze() {
-    // ͷԴ
-    for (auto& pair : textures) {
-        UnloadTexture(pair.second);
+TileType Maze::get_edited_tile_type(Coordinate c) const {
+    for (auto it = pending_edits.rbegin(); it != pending_edits.rend(); ++it) {
+        if (it->first == c) return it->second;
     }
+    return get_tile_type(c);
 }
 
-void Maze::set_current_path(PathType type) {
-    current_path_type = type;
-}
+bool Maze::set_tile_type(Coordinate c, TileType type) {
+    if (type == get_edited_tile_type(c)) return false;
+    bool revert = type == get_tile_type(c); // Ļеԭֻͣ賷øݴ޸
+    if (!revert && !can_set_tile(c, type)) return false;
 
-void Maze::draw_path_marker(Coordinate c, Color color) const {
-    Vector2 pos = get_tile_position(c);
-    DrawRectangle(
-        static_cast<int>(pos.x + TILE_WIDTH / 2 - 8),
-        static_cast<int>(pos.y + TILE_HEIGHT / 2 - 8),
-        16, 16,
-        color
-    );
+    // ͬһֻµһݴ޸
+    std::erase_if(pending_edits, [c](const std::pair<Coordinate, TileType>& edit) { return edit.first == c; });
+    if (!revert) pending_edits.push_back({ c, type });
+    apply_pending_edits();
+    return true;
 }
 
-void Maze::draw(const Camera2D& camera) {
-    BeginMode2D(camera);
-    // еؿ
-    for (const auto& row : tiles) {
-        for (const auto& tile : row) {
-            DrawTextureV(textures[tile.type], tile.position, WHITE);
-        }
+void Maze::apply_pending_edits() {
+    std::erase_if(retired_tasks, [](const std::future<void>& task) {
+        return task.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    });
+    if (pending_edits.empty()) return;
+
+    std::unique_lock<std::mutex> lock(solver_mutex, std::try_to_lock);
+    if (!lock.owns_lock()) return;
+
+    enable_incremental_planning(); // ̻߳ȡ˿أ
+    bool changed = false;
+    for (const auto& [c, type] : pending_edits) {
+        if (!MazeCore::set_tile_type(c, type)) continue;
+        invalidate_tile(c);
+        ++edit_count;
+        changed = true;
     }
+    pending_edits.clear();
+    if (!changed) return;
 
-    // ѡе·
-    switch (current_path_type) {
-    case PathType::DFS:
-        for (const auto& c : dfs_path) {
-            draw_path_marker(c, Color{ 255, 0, 0, 150 }); // ɫ
-        }
-        break;
-    case PathType::BFS:
-        for (const auto& c : bfs_path) {
-            draw_path_marker(c, Color{ 0, 0, 255, 150 }); // ɫ
-        }
-        break;
-    case PathType::DIJKSTRA:
-        for (const auto& c : dijkstra_path) {
-            draw_path_marker(c, Color{ 0, 255, 0, 150 }); // ɫ
-        }
-        break;
-    default: // NONE
-        break;
+    // нϣδretired_tasksŶеĻ
+    // ʾе·볡
+    for (auto& pair : path_tasks) {
+        retired_tasks.push_back(std::move(pair.second));
     }
-    EndMode2D();
+    path_tasks.clear();
+    if (exit_field_task.valid()) retired_tasks.push_back(std::move(exit_field_task));
+    path_overlays.clear();
+    hint_overlay.clear();
+    hint_from = { -1, -1 };
+    lock.unlock();
+
+    for (PathType type : shown_paths) {
+        request_path(type);
+    }
+    if (show_route_hint) request_exit_field();
 }
 
-Coordinate Maze::get_start_coord() const { return start_coord; }
-Coordinate Maze::get_end_coord() const { return end_coord; }
-TileType Maze::get_tile_type(const Coordinate& coord) const {
-    if (coord.y >= 0 && coord.y < rows && coord.x >= 0 && coord.x < cols) {
-        return tiles[coord.y][coord.x].type;
-    }
-    return TileType::WALL;
+int Maze::get_edit_count() const { return edit_count; }
+
+Coordinate Maze::get_tile_coord(Vector2 world) const {
+    return {
+        static_cast<int>(std::floor(world.x / TILE_WIDTH)),
+        static_cast<int>(std::floor(world.y / TILE_HEIGHT))
+    };
 }
+
+const DrawStats& Maze::get_draw_stats() const { return draw_stats; }
+
 Vector2 Maze::get_tile_position(const Coordinate& coord) const {
     if (coord.y >= 0 && coord.y < rows && coord.x >= 0 && coord.x < cols) {
-        return tiles[coord.y][coord.x].position;
+        return {
+            static_cast<float>(coord.x * TILE_WIDTH),
+            static_cast<float>(coord.y * TILE_HEIGHT)
+        };
     }
     return { 0, 0 };
-}
-int Maze::get_rows() const { return rows; }
-int Maze::get_cols() const { return cols; }
\ No newline at end of file
+}
\ No newline at end of file
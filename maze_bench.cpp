@@ -0,0 +1,251 @@
+﻿#include "bench_alloc.h"
+#include "maze_core.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// 无窗口基准测试：固定种子，按尺寸计时生成、校验、加载与各寻路算法，
+// 以及单格修改后增量修复（LPA*）与整图重搜的对比，
+// 报告中位数与百分位耗时、展开节点数、堆内存峰值与分配次数，并输出JSON
+
+// 一项操作在多次重复中的统计
+struct BenchResult {
+    std::string name;
+    int size = 0;
+    std::vector<double> times_ms;
+    size_t expanded = 0;      // 寻路展开的节点数（其余操作为0）
+    size_t path_length = 0;
+    size_t peak_heap = 0;     // 单次执行期间堆占用相对开始时的最大增量
+    uint64_t allocations = 0; // 单次执行的分配次数（各次相同，取最后一次）
+};
+
+static double percentile(std::vector<double> values, double p) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    double rank = p * (values.size() - 1);
+    size_t lo = static_cast<size_t>(rank);
+    size_t hi = std::min(lo + 1, values.size() - 1);
+    return values[lo] + (values[hi] - values[lo]) * (rank - lo);
+}
+
+// 重复执行op，记录每次耗时、堆峰值与分配次数
+static BenchResult measure(const std::string& name, int size, int reps, const std::function<void()>& op) {
+    BenchResult result;
+    result.name = name;
+    result.size = size;
+    for (int r = 0; r < reps; ++r) {
+        size_t base = get_live_heap();
+        reset_peak_heap();
+        uint64_t allocs = get_alloc_count();
+        auto start = std::chrono::steady_clock::now();
+        op();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        result.times_ms.push_back(elapsed.count());
+        result.peak_heap = std::max(result.peak_heap, get_peak_heap() - base);
+        result.allocations = get_alloc_count() - allocs;
+    }
+    return result;
+}
+
+static const char* algo_name(PathType type) {
+    switch (type) {
+    case PathType::DFS: return "dfs";
+    case PathType::BFS: return "bfs";
+    case PathType::DIJKSTRA: return "dijkstra";
+    case PathType::ASTAR: return "astar";
+    case PathType::BIDIRECTIONAL_BFS: return "bibfs";
+    case PathType::BIDIRECTIONAL_DIJKSTRA: return "bidijkstra";
+    default: return "none";
+    }
+}
+
+static void print_usage() {
+    std::cerr << "Usage:\n"
+        << "  maze_bench [--sizes 15,101,1001,4001] [--reps N] [--seed N] [--json out.json] [--tmp dir]\n"
+        << "             [--edit-size N] [--edits N]\n";
+}
+
+static std::vector<int> parse_sizes(const std::string& text) {
+    std::vector<int> sizes;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        int n = std::atoi(item.c_str());
+        if (n >= 3) sizes.push_back(n);
+    }
+    return sizes;
+}
+
+static void write_json(std::ostream& out, const std::vector<BenchResult>& results, uint32_t seed, int reps) {
+    out << "{\n  \"seed\": " << seed << ",\n  \"reps\": " << reps << ",\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        out << "    {\"name\": \"" << r.name << "\", \"size\": " << r.size
+            << ", \"median_ms\": " << percentile(r.times_ms, 0.5)
+            << ", \"p90_ms\": " << percentile(r.times_ms, 0.9)
+            << ", \"p99_ms\": " << percentile(r.times_ms, 0.99)
+            << ", \"min_ms\": " << percentile(r.times_ms, 0.0)
+            << ", \"max_ms\": " << percentile(r.times_ms, 1.0)
+            << ", \"expanded\": " << r.expanded << ", \"path_length\": " << r.path_length
+            << ", \"peak_heap_bytes\": " << r.peak_heap << ", \"allocations\": " << r.allocations << "}"
+            << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+}
+
+int main(int argc, char** argv) {
+    std::vector<int> sizes = { 15, 101, 1001, 4001 };
+    int reps = 5;
+    uint32_t seed = 12345;
+    std::string json_path;
+    std::string tmp_dir = ".";
+    int edit_size = 2001;
+    int edits = 200;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--sizes") == 0 && i + 1 < argc) {
+            sizes = parse_sizes(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--reps") == 0 && i + 1 < argc) {
+            reps = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json_path = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--tmp") == 0 && i + 1 < argc) {
+            tmp_dir = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--edit-size") == 0 && i + 1 < argc) {
+            edit_size = std::max(3, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--edits") == 0 && i + 1 < argc) {
+            edits = std::max(0, std::atoi(argv[++i]));
+        }
+        else {
+            print_usage();
+            return 1;
+        }
+    }
+
+    const PathType algos[] = {
+        PathType::DFS, PathType::BFS, PathType::DIJKSTRA, PathType::ASTAR,
+        PathType::BIDIRECTIONAL_BFS, PathType::BIDIRECTIONAL_DIJKSTRA
+    };
+    std::vector<BenchResult> results;
+    for (int n : sizes) {
+        std::unique_ptr<MazeCore> maze;
+        results.push_back(measure("generate", n, reps, [&] { maze = std::make_unique<MazeCore>(n, n, seed); }));
+        results.push_back(measure("validate", n, reps, [&] { maze->validate_maze_path(); }));
+
+        // 加载：同一迷宫分别存成文本与二进制格式后计时读回
+        const std::pair<const char*, MazeFileFormat> formats[] = {
+            { "load_text", MazeFileFormat::TEXT }, { "load_binary", MazeFileFormat::BINARY }
+        };
+        for (const auto& [name, format] : formats) {
+            std::string path = tmp_dir + "/maze_bench_" + std::to_string(n) + (format == MazeFileFormat::TEXT ? ".txt" : ".mzb");
+            if (!maze->save_maze(path, format)) return 1;
+            results.push_back(measure(name, n, reps, [&] { MazeCore loaded(path); }));
+            std::remove(path.c_str());
+        }
+
+        for (PathType type : algos) {
+            BenchResult r = measure(std::string("solve_") + algo_name(type), n, reps, [&] { maze->compute_path(type); });
+            r.expanded = maze->get_expanded_nodes(type);
+            r.path_length = maze->get_path(type).size();
+            results.push_back(std::move(r));
+        }
+    }
+
+    // 动态修改：同一种子生成两份迷宫，按相同顺序随机翻转一格墙/地板再翻回
+    // （完美迷宫堵住一格常会断开起终点，翻回后保持迷宫整体不变，打通与堵住各占一半），
+    // 一份启用增量寻路逐次修复，一份每次修改后整图重跑Dijkstra，逐次比对代价
+    if (edits > 0) {
+        MazeCore dynamic(edit_size, edit_size, seed);
+        MazeCore full(edit_size, edit_size, seed);
+        dynamic.enable_incremental_planning();
+        results.push_back(measure("replan_initial", edit_size, 1, [&] { dynamic.compute_path(PathType::DIJKSTRA); }));
+        results.back().expanded = dynamic.get_expanded_nodes(PathType::DIJKSTRA);
+        results.back().path_length = dynamic.get_path(PathType::DIJKSTRA).size();
+
+        BenchResult replan;
+        replan.name = "replan_edit";
+        replan.size = edit_size;
+        BenchResult resolve;
+        resolve.name = "resolve_edit";
+        resolve.size = edit_size;
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> rand_coord(1, edit_size - 2);
+        int mismatched = 0;
+        size_t replan_expanded = 0;
+        size_t resolve_expanded = 0;
+        for (int e = 0; e < edits;) {
+            Coordinate c = { rand_coord(rng), rand_coord(rng) };
+            TileType old_type = dynamic.get_tile_type(c);
+            if (old_type != TileType::WALL && old_type != TileType::FLOOR) continue;
+            TileType new_type = old_type == TileType::WALL ? TileType::FLOOR : TileType::WALL;
+
+            for (TileType type : { new_type, old_type }) {
+                ++e;
+                BenchResult a = measure("", edit_size, 1, [&] {
+                    dynamic.set_tile_type(c, type);
+                    dynamic.compute_path(PathType::DIJKSTRA);
+                });
+                BenchResult b = measure("", edit_size, 1, [&] {
+                    full.set_tile_type(c, type);
+                    full.compute_path(PathType::DIJKSTRA);
+                });
+                for (auto [from, to] : { std::pair{ &a, &replan }, std::pair{ &b, &resolve } }) {
+                    to->times_ms.push_back(from->times_ms[0]);
+                    to->peak_heap = std::max(to->peak_heap, from->peak_heap);
+                    to->allocations = from->allocations;
+                }
+                replan_expanded += dynamic.get_expanded_nodes(PathType::DIJKSTRA);
+                resolve_expanded += full.get_expanded_nodes(PathType::DIJKSTRA);
+                // 不可达时两者代价都为0（整图Dijkstra此时返回只含终点的路径）
+                if (dynamic.get_path_cost(dynamic.get_path(PathType::DIJKSTRA)) != full.get_path_cost(full.get_path(PathType::DIJKSTRA))) {
+                    ++mismatched;
+                }
+            }
+        }
+        // 展开节点数取每次修改的平均值
+        replan.expanded = replan_expanded / replan.times_ms.size();
+        replan.path_length = dynamic.get_path(PathType::DIJKSTRA).size();
+        resolve.expanded = resolve_expanded / resolve.times_ms.size();
+        resolve.path_length = full.get_path(PathType::DIJKSTRA).size();
+        std::fprintf(stderr, "edits=%zu mismatched=%d\n", replan.times_ms.size(), mismatched);
+        results.push_back(std::move(replan));
+        results.push_back(std::move(resolve));
+        if (mismatched > 0) return 2;
+    }
+
+    // 人读的表格输出到stderr，JSON输出到文件或stdout
+    for (const BenchResult& r : results) {
+        std::fprintf(stderr, "%-18s size=%-6d median=%10.3fms p90=%10.3fms p99=%10.3fms expanded=%-10zu peak_heap=%-10zu allocs=%llu\n",
+            r.name.c_str(), r.size, percentile(r.times_ms, 0.5), percentile(r.times_ms, 0.9), percentile(r.times_ms, 0.99),
+            r.expanded, r.peak_heap, static_cast<unsigned long long>(r.allocations));
+    }
+    if (json_path.empty()) {
+        write_json(std::cout, results, seed, reps);
+    }
+    else {
+        std::ofstream out(json_path);
+        if (!out.is_open()) {
+            std::cerr << "Failed to open " << json_path << std::endl;
+            return 1;
+        }
+        write_json(out, results, seed, reps);
+    }
+    return 0;
+}
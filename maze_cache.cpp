@@ -0,0 +1,228 @@
+#include "maze_cache.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// ·ļħ
+static const char PATH_FILE_MAGIC[4] = { 'M', 'Z', 'P', 'T' };
+
+static double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - start;
+    return duration.count();
+}
+
+// ص·ʽһ£Ϊ𻵣
+// ɴʱ㵽յ㡢ߵڵĿͨиǽҶߣ
+// ɴʱDFSΪաBFSDijkstraֻյ㣬ȷʵͨ
+static bool is_valid_cached_path(const MazeCore& maze, PathType type, const std::vector<Coordinate>& path) {
+    bool unreachable = type == PathType::DFS
+        ? path.empty()
+        : path.size() == 1 && path[0] == maze.get_end_coord() && !(path[0] == maze.get_start_coord());
+    if (unreachable) return !maze.validate_maze_path();
+
+    if (path.empty()) return false;
+    if (!(path.front() == maze.get_start_coord()) || !(path.back() == maze.get_end_coord())) return false;
+    for (size_t i = 0; i < path.size(); ++i) {
+        const Coordinate& c = path[i];
+        if (c.x < 0 || c.x >= maze.get_cols() || c.y < 0 || c.y >= maze.get_rows()) return false;
+        TileType tile = maze.get_tile_type(c);
+        if (tile == TileType::WALL || tile == TileType::LAVA) return false;
+        if (i > 0 && std::abs(c.x - path[i - 1].x) + std::abs(c.y - path[i - 1].y) != 1) return false;
+    }
+    return true;
+}
+
+MazeCache::MazeCache(const std::string& dir_, size_t max_bytes_) : dir(dir_), max_bytes(max_bytes_) {
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+    for (const auto& entry : fs::directory_iterator(dir, ec)) {
+        if (entry.is_regular_file(ec)) stats.disk_bytes += entry.file_size(ec);
+    }
+}
+
+std::string MazeCache::entry_key(const MazeGenParams& params) const {
+    // ļʽ汾Ҳʽ仯ĿȻʧЧ
+    return "r" + std::to_string(params.rows) + "_c" + std::to_string(params.cols)
+        + "_s" + std::to_string(params.seed) + "_t" + std::to_string(params.threads)
+        + "_v" + std::to_string(MAZE_FILE_VERSION);
+}
+
+std::optional<MazeCore> MazeCache::load_entry(const std::string& key) const {
+    fs::path grid_path = fs::path(dir) / (key + ".mzb");
+    fs::path path_path = fs::path(dir) / (key + ".path");
+    std::error_code ec;
+    if (!fs::exists(grid_path, ec)) return std::nullopt;
+
+    MazeCore loaded(grid_path.string());
+    if (loaded.get_rows() == 0) return std::nullopt;
+
+    // ·ļֻڵ÷Уȱʧʱֻ
+    auto now = fs::file_time_type::clock::now();
+    if (!fs::exists(path_path, ec)) {
+        fs::last_write_time(grid_path, now, ec);
+        return loaded;
+    }
+
+    std::ifstream file(path_path, std::ios::binary);
+    char magic[4] = {};
+    uint32_t count = 0;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&count), sizeof(count));
+    if (!file || std::memcmp(magic, PATH_FILE_MAGIC, sizeof(magic)) != 0) return std::nullopt;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        uint8_t type = 0;
+        uint32_t length = 0;
+        file.read(reinterpret_cast<char*>(&type), sizeof(type));
+        file.read(reinterpret_cast<char*>(&length), sizeof(length));
+        if (!file || length > static_cast<size_t>(loaded.get_rows()) * loaded.get_cols()) return std::nullopt;
+        if (std::find(std::begin(MAZE_CACHE_PATHS), std::end(MAZE_CACHE_PATHS), static_cast<PathType>(type))
+            == std::end(MAZE_CACHE_PATHS)) return std::nullopt;
+        std::vector<Coordinate> path(length);
+        file.read(reinterpret_cast<char*>(path.data()), static_cast<std::streamsize>(length * sizeof(Coordinate)));
+        if (!file || !is_valid_cached_path(loaded, static_cast<PathType>(type), path)) return std::nullopt;
+        loaded.set_path(static_cast<PathType>(type), std::move(path));
+    }
+
+    // мΪʹ
+    fs::last_write_time(grid_path, now, ec);
+    fs::last_write_time(path_path, now, ec);
+    return loaded;
+}
+
+void MazeCache::untrack_file(const fs::path& path) {
+    std::error_code ec;
+    if (!fs::exists(path, ec)) return;
+    stats.disk_bytes -= std::min(stats.disk_bytes, static_cast<size_t>(fs::file_size(path, ec)));
+}
+
+bool MazeCache::store_entry(const std::string& key, const MazeCore& maze) {
+    fs::path grid_path = fs::path(dir) / (key + ".mzb");
+    fs::path path_path = fs::path(dir) / (key + ".path");
+    std::error_code ec;
+    // Ŀʧܺɣʱȿ۵ļɵĿþɵ·ļ
+    untrack_file(grid_path);
+    untrack_file(path_path);
+    fs::remove(path_path, ec);
+    if (!maze.save_maze(grid_path.string(), MazeFileFormat::BINARY)) {
+        fs::remove(grid_path, ec);
+        return false;
+    }
+
+    stats.disk_bytes += fs::file_size(grid_path, ec);
+    return true;
+}
+
+bool MazeCache::store_path_file(const std::string& key, const MazeCore& maze, const std::vector<PathType>& types) {
+    fs::path path_path = fs::path(dir) / (key + ".path");
+    std::error_code ec;
+    untrack_file(path_path);
+
+    std::ofstream file(path_path, std::ios::binary);
+    uint32_t count = static_cast<uint32_t>(types.size());
+    file.write(PATH_FILE_MAGIC, sizeof(PATH_FILE_MAGIC));
+    file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    for (PathType type : types) {
+        const std::vector<Coordinate>& path = maze.get_path(type);
+        uint8_t t = static_cast<uint8_t>(type);
+        uint32_t length = static_cast<uint32_t>(path.size());
+        file.write(reinterpret_cast<const char*>(&t), sizeof(t));
+        file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        file.write(reinterpret_cast<const char*>(path.data()), static_cast<std::streamsize>(length * sizeof(Coordinate)));
+    }
+    file.close();
+    if (!file) {
+        fs::remove(path_path, ec);
+        return false;
+    }
+
+    stats.disk_bytes += fs::file_size(path_path, ec);
+    return true;
+}
+
+void MazeCache::evict_to_budget(const std::string& keep_key) {
+    if (stats.disk_bytes <= max_bytes) return;
+
+    // ļȥչļΪһĿԽµ޸ʱΪʹʱ
+    struct CacheEntry {
+        std::vector<fs::path> files;
+        fs::file_time_type time = fs::file_time_type::min();
+        size_t size = 0;
+    };
+    std::map<std::string, CacheEntry> entries;
+    std::error_code ec;
+    for (const auto& file : fs::directory_iterator(dir, ec)) {
+        if (!file.is_regular_file(ec)) continue;
+        CacheEntry& entry = entries[file.path().stem().string()];
+        entry.files.push_back(file.path());
+        entry.time = std::max(entry.time, file.last_write_time(ec));
+        entry.size += static_cast<size_t>(file.file_size(ec));
+    }
+
+    std::vector<std::pair<std::string, CacheEntry*>> order;
+    stats.disk_bytes = 0;
+    for (auto& [key, entry] : entries) {
+        stats.disk_bytes += entry.size;
+        if (key != keep_key) order.emplace_back(key, &entry);
+    }
+    std::sort(order.begin(), order.end(), [](const auto& a, const auto& b) { return a.second->time < b.second->time; });
+
+    // δõĿɾ𣬸дĿʹҲ
+    for (const auto& [key, entry] : order) {
+        if (stats.disk_bytes <= max_bytes) break;
+        for (const fs::path& path : entry->files) fs::remove(path, ec);
+        stats.disk_bytes -= entry->size;
+        ++stats.evictions;
+    }
+}
+
+MazeCore MazeCache::load_or_generate(const MazeGenParams& params, ProgressCallback progress) {
+    // ɶ߳ʱȡͳƣֻд̭ڽ
+    std::string key = entry_key(params);
+    auto start = std::chrono::steady_clock::now();
+    if (std::optional<MazeCore> cached = load_entry(key)) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++stats.hits;
+        stats.load_ms += elapsed_ms(start);
+        if (progress) progress(1.0f);
+        return std::move(*cached);
+    }
+
+    MazeCore maze = params.threads > 0
+        ? MazeCore(params.rows, params.cols, params.seed, params.threads)
+        : MazeCore(params.rows, params.cols, params.seed, std::move(progress));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ++stats.misses;
+    stats.generate_ms += elapsed_ms(start);
+    if (!store_entry(key, maze)) {
+        std::cerr << "Failed to write maze cache entry " << key << std::endl;
+    }
+    evict_to_budget(key);
+    return maze;
+}
+
+void MazeCache::store_paths(const MazeGenParams& params, const MazeCore& maze, const std::vector<PathType>& types) {
+    std::string key = entry_key(params);
+    std::lock_guard<std::mutex> lock(mutex);
+    // Ŀѱ̭ʱٵ·
+    std::error_code ec;
+    if (!fs::exists(fs::path(dir) / (key + ".mzb"), ec)) return;
+    if (!store_path_file(key, maze, types)) {
+        std::cerr << "Failed to write maze cache paths " << key << std::endl;
+    }
+    evict_to_budget(key);
+}
+
+MazeCacheStats MazeCache::get_stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
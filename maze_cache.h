@@ -0,0 +1,71 @@
+#ifndef MAZE_CACHE_H
+#define MAZE_CACHE_H
+
+// ɽĴ̻棺(, , , )DFS/BFS/Dijkstra·
+// ڵ÷в棻ٴͬһʱֱӶأĿ¼ܴСʱ̭δõĿ
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+#include "maze_core.h"
+
+// ĬϻĿ¼
+const char* const DEFAULT_MAZE_CACHE_DIR = "maze_cache";
+const size_t DEFAULT_MAZE_CACHE_BYTES = 64u << 20;
+
+// ɲ·
+const PathType MAZE_CACHE_PATHS[] = { PathType::DFS, PathType::BFS, PathType::DIJKSTRA };
+
+// ͳƣʡɺʱ
+struct MazeCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    double load_ms = 0.0;      // ʱصۼƺʱ
+    double generate_ms = 0.0;  // δʱɵۼƺʱ
+    size_t disk_bytes = 0;     // Ŀ¼ǰռ
+
+    double hit_rate() const { return hits + misses > 0 ? static_cast<double>(hits) / (hits + misses) : 0.0; }
+};
+
+// ɲthreads > 0ʱʹ÷ֿ鲢뵥߳ͬ˼
+struct MazeGenParams {
+    int rows = 0;
+    int cols = 0;
+    uint32_t seed = 0;
+    int threads = 0;
+};
+
+// MazeCacheÿĿһļ<>.mzbΪ<>.pathΪѲ·
+// ʱļ޸ʱ䣬̭ʱ޸ʱӾɵɾڶ߳ʹ
+class MazeCache {
+private:
+    std::string dir;
+    size_t max_bytes;
+    mutable std::mutex mutex;
+    MazeCacheStats stats;
+
+    std::string entry_key(const MazeGenParams& params) const;
+    std::optional<MazeCore> load_entry(const std::string& key) const;
+    // disk_bytesп۵ǻɾļʱ䣩
+    void untrack_file(const std::filesystem::path& path);
+    bool store_entry(const std::string& key, const MazeCore& maze);
+    bool store_path_file(const std::string& key, const MazeCore& maze, const std::vector<PathType>& types);
+    void evict_to_budget(const std::string& keep_key);
+
+public:
+    MazeCache(const std::string& dir_ = DEFAULT_MAZE_CACHE_DIR, size_t max_bytes_ = DEFAULT_MAZE_CACHE_BYTES);
+
+    // ʱѲ·δʱֻд뻺棬
+    MazeCore load_or_generate(const MazeGenParams& params, ProgressCallback progress = nullptr);
+
+    // maze·typesȡMAZE_CACHE_PATHSmazeparamsɵһ£
+    // ǸĿԭе·ļ
+    void store_paths(const MazeGenParams& params, const MazeCore& maze, const std::vector<PathType>& types);
+
+    MazeCacheStats get_stats() const;
+};
+
+#endif // MAZE_CACHE_H
@@ -0,0 +1,554 @@
+﻿#include "maze_core.h"
+#include "player_sim.h"
+#include "replay.h"
+#include "maze_cache.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+
+// 无窗口命令行工具：批量生成迷宫、求解并输出耗时
+
+static void print_usage() {
+    std::cerr << "Usage:\n"
+        << "  maze_cli gen <rows> <cols> [--seed N] [--threads N] [-o file] [--format text|packed|binary|chunked]\n"
+        << "                [--cache dir] [--cache-mb N]\n"
+        << "  maze_cli stream <rows> <cols> -o file [--seed N] [--format text|packed|binary|chunked]\n"
+        << "  maze_cli convert <in> <out> [--format text|packed|binary|chunked]\n"
+        << "  maze_cli solve <file> [--algo dfs|bfs|dijkstra|astar|bibfs|bidijkstra|all] [--queue auto|heap|bucket]\n"
+        << "                  [--bfs auto|queue|bitset] [--cache-mb N] [--solver-mb N]\n"
+        << "  maze_cli validate <file> [--bfs auto|queue|bitset] [--cache-mb N]\n"
+        << "  maze_cli sim <file> [--algo dfs|bfs|dijkstra|astar|bibfs|bidijkstra] [--max-ticks N] [--record out.mzr]\n"
+        << "  maze_cli replay <log.mzr>... [--repeat N]\n"
+        << "  maze_cli hint <file> [--samples N] [--seed N]\n";
+}
+
+static double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - start;
+    return duration.count();
+}
+
+static bool parse_algo(const std::string& name, PathType& type) {
+    if (name == "dfs") type = PathType::DFS;
+    else if (name == "bfs") type = PathType::BFS;
+    else if (name == "dijkstra") type = PathType::DIJKSTRA;
+    else if (name == "astar") type = PathType::ASTAR;
+    else if (name == "bibfs") type = PathType::BIDIRECTIONAL_BFS;
+    else if (name == "bidijkstra") type = PathType::BIDIRECTIONAL_DIJKSTRA;
+    else return false;
+    return true;
+}
+
+static bool parse_bfs_mode(const std::string& name, BfsMode& mode) {
+    if (name == "auto") mode = BfsMode::AUTO;
+    else if (name == "queue") mode = BfsMode::QUEUE;
+    else if (name == "bitset") mode = BfsMode::BITSET;
+    else return false;
+    return true;
+}
+
+static bool parse_format(const std::string& name, MazeFileFormat& format) {
+    if (name == "text") format = MazeFileFormat::TEXT;
+    else if (name == "packed") format = MazeFileFormat::PACKED;
+    else if (name == "binary") format = MazeFileFormat::BINARY;
+    else if (name == "chunked") format = MazeFileFormat::CHUNKED;
+    else return false;
+    return true;
+}
+
+// 分块文件的缓存计数，非分块存储时不输出
+static void print_cache_stats(const MazeCore& maze) {
+    if (!maze.is_chunked()) return;
+    ChunkCacheStats stats = maze.get_chunk_cache_stats();
+    std::cout << "cache hits=" << stats.hits << " misses=" << stats.misses
+        << " evictions=" << stats.evictions << " resident_mb=" << (stats.resident_bytes >> 20)
+        << " budget_mb=" << (stats.budget_bytes >> 20) << std::endl;
+}
+
+static const char* algo_name(PathType type) {
+    switch (type) {
+    case PathType::DFS: return "dfs";
+    case PathType::BFS: return "bfs";
+    case PathType::DIJKSTRA: return "dijkstra";
+    case PathType::ASTAR: return "astar";
+    case PathType::BIDIRECTIONAL_BFS: return "bibfs";
+    case PathType::BIDIRECTIONAL_DIJKSTRA: return "bidijkstra";
+    default: return "none";
+    }
+}
+
+static int run_gen(int argc, char** argv) {
+    if (argc < 4) {
+        print_usage();
+        return 1;
+    }
+    int rows = std::atoi(argv[2]);
+    int cols = std::atoi(argv[3]);
+    if (rows < 3 || cols < 3) {
+        std::cerr << "Maze size must be at least 3x3" << std::endl;
+        return 1;
+    }
+
+    uint32_t seed = std::random_device{}();
+    int threads = 0; // 0：单线程随机DFS；>=1：分块并行生成
+    MazeFileFormat format = MazeFileFormat::TEXT;
+    std::string out_path;
+    std::string cache_dir; // 非空时经磁盘缓存生成（只缓存网格）
+    size_t cache_bytes = DEFAULT_MAZE_CACHE_BYTES;
+    for (int i = 4; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--cache") == 0 && i + 1 < argc) {
+            cache_dir = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--cache-mb") == 0 && i + 1 < argc) {
+            cache_bytes = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10)) << 20;
+        }
+        else if (std::strcmp(argv[i], "--packed") == 0) {
+            format = MazeFileFormat::PACKED;
+        }
+        else if (std::strcmp(argv[i], "--format") == 0 && i + 1 < argc && parse_format(argv[i + 1], format)) {
+            ++i;
+        }
+        else {
+            print_usage();
+            return 1;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::unique_ptr<MazeCore> maze;
+    if (!cache_dir.empty()) {
+        MazeCache cache(cache_dir, cache_bytes);
+        maze = std::make_unique<MazeCore>(cache.load_or_generate({ rows, cols, seed, threads }));
+        MazeCacheStats stats = cache.get_stats();
+        std::cerr << "cache hit=" << (stats.hits > 0 ? "yes" : "no") << " load_ms=" << stats.load_ms
+            << " generate_ms=" << stats.generate_ms << " evictions=" << stats.evictions
+            << " disk_mb=" << (stats.disk_bytes >> 20) << std::endl;
+    }
+    else {
+        maze = (threads > 0)
+            ? std::make_unique<MazeCore>(rows, cols, seed, threads)
+            : std::make_unique<MazeCore>(rows, cols, seed);
+    }
+    double gen_ms = elapsed_ms(start);
+
+    std::cerr << "gen rows=" << maze->get_rows() << " cols=" << maze->get_cols()
+        << " seed=" << seed << " threads=" << threads << " time_ms=" << gen_ms << std::endl;
+    if (!out_path.empty()) {
+        return maze->save_maze(out_path, format) ? 0 : 1;
+    }
+    return 0;
+}
+
+static int run_stream(int argc, char** argv) {
+    if (argc < 4) {
+        print_usage();
+        return 1;
+    }
+    int rows = std::atoi(argv[2]);
+    int cols = std::atoi(argv[3]);
+    if (rows < 3 || cols < 3) {
+        std::cerr << "Maze size must be at least 3x3" << std::endl;
+        return 1;
+    }
+
+    uint32_t seed = std::random_device{}();
+    MazeFileFormat format = MazeFileFormat::TEXT;
+    std::string out_path;
+    for (int i = 4; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--packed") == 0) {
+            format = MazeFileFormat::PACKED;
+        }
+        else if (std::strcmp(argv[i], "--format") == 0 && i + 1 < argc && parse_format(argv[i + 1], format)) {
+            ++i;
+        }
+        else {
+            print_usage();
+            return 1;
+        }
+    }
+    if (out_path.empty()) {
+        print_usage();
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    bool ok = generate_eller_maze_file(rows, cols, seed, out_path, format);
+    std::cerr << "stream rows=" << rows << " cols=" << cols << " seed=" << seed
+        << " time_ms=" << elapsed_ms(start) << std::endl;
+    return ok ? 0 : 1;
+}
+
+static int run_convert(int argc, char** argv) {
+    if (argc < 4) {
+        print_usage();
+        return 1;
+    }
+    MazeFileFormat format = MazeFileFormat::BINARY;
+    for (int i = 4; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--format") == 0 && i + 1 < argc && parse_format(argv[i + 1], format)) {
+            ++i;
+        }
+        else {
+            print_usage();
+            return 1;
+        }
+    }
+
+    // 输入格式按魔数自动识别
+    auto start = std::chrono::steady_clock::now();
+    MazeCore maze(argv[2]);
+    double load_ms = elapsed_ms(start);
+    if (maze.get_rows() == 0) return 1;
+
+    start = std::chrono::steady_clock::now();
+    bool ok = maze.save_maze(argv[3], format);
+    std::cout << "convert rows=" << maze.get_rows() << " cols=" << maze.get_cols()
+        << " load_ms=" << load_ms << " save_ms=" << elapsed_ms(start) << std::endl;
+    return ok ? 0 : 1;
+}
+
+static int run_solve(int argc, char** argv) {
+    if (argc < 3) {
+        print_usage();
+        return 1;
+    }
+    std::string algo = "all";
+    std::string queue = "auto";
+    BfsMode bfs_mode = BfsMode::AUTO;
+    size_t cache_bytes = DEFAULT_CHUNK_CACHE_BYTES;
+    size_t solver_bytes = DEFAULT_SOLVER_STATE_BYTES;
+    for (int i = 3; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--algo") == 0 && i + 1 < argc) {
+            algo = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--queue") == 0 && i + 1 < argc) {
+            queue = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--bfs") == 0 && i + 1 < argc) {
+            if (!parse_bfs_mode(argv[++i], bfs_mode)) {
+                print_usage();
+                return 1;
+            }
+        }
+        else if (std::strcmp(argv[i], "--cache-mb") == 0 && i + 1 < argc) {
+            cache_bytes = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10)) << 20;
+        }
+        else if (std::strcmp(argv[i], "--solver-mb") == 0 && i + 1 < argc) {
+            solver_bytes = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10)) << 20;
+        }
+        else {
+            print_usage();
+            return 1;
+        }
+    }
+
+    std::vector<PathType> types;
+    PathType type;
+    if (algo == "all") {
+        types = {
+            PathType::DFS, PathType::BFS, PathType::DIJKSTRA, PathType::ASTAR,
+            PathType::BIDIRECTIONAL_BFS, PathType::BIDIRECTIONAL_DIJKSTRA
+        };
+    }
+    else if (parse_algo(algo, type)) {
+        types = { type };
+    }
+    else {
+        std::cerr << "Unknown algorithm: " << algo << std::endl;
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    MazeCore maze(argv[2], cache_bytes);
+    double load_ms = elapsed_ms(start);
+    if (maze.get_rows() == 0) return 1;
+
+    if (queue == "heap") maze.set_dijkstra_queue(DijkstraQueue::BINARY_HEAP);
+    else if (queue == "bucket") maze.set_dijkstra_queue(DijkstraQueue::BUCKET);
+    else if (queue != "auto") {
+        std::cerr << "Unknown queue: " << queue << std::endl;
+        return 1;
+    }
+    maze.set_bfs_mode(bfs_mode);
+    maze.set_solver_state_limit(solver_bytes);
+    std::cout << "load rows=" << maze.get_rows() << " cols=" << maze.get_cols()
+        << " time_ms=" << load_ms << std::endl;
+
+    bool skipped = false;
+    for (PathType t : types) {
+        start = std::chrono::steady_clock::now();
+        const std::vector<Coordinate>& path = maze.compute_path(t);
+        double solve_ms = elapsed_ms(start);
+        if (!maze.has_path(t)) {
+            // 分块迷宫上求解状态超出--solver-mb，未求解
+            std::cout << "solve algo=" << algo_name(t) << " skipped" << std::endl;
+            skipped = true;
+            continue;
+        }
+        std::cout << "solve algo=" << algo_name(t) << " length=" << path.size()
+            << " cost=" << maze.get_path_cost(path) << " expanded=" << maze.get_expanded_nodes(t)
+            << " time_ms=" << solve_ms << std::endl;
+    }
+    print_cache_stats(maze);
+    return skipped ? 1 : 0;
+}
+
+static int run_validate(int argc, char** argv) {
+    if (argc < 3) {
+        print_usage();
+        return 1;
+    }
+    BfsMode bfs_mode = BfsMode::AUTO;
+    size_t cache_bytes = DEFAULT_CHUNK_CACHE_BYTES;
+    for (int i = 3; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--bfs") == 0 && i + 1 < argc && parse_bfs_mode(argv[i + 1], bfs_mode)) {
+            ++i;
+        }
+        else if (std::strcmp(argv[i], "--cache-mb") == 0 && i + 1 < argc) {
+            cache_bytes = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10)) << 20;
+        }
+        else {
+            print_usage();
+            return 1;
+        }
+    }
+
+    MazeCore maze(argv[2], cache_bytes);
+    if (maze.get_rows() == 0) return 1;
+    maze.set_bfs_mode(bfs_mode);
+
+    auto start = std::chrono::steady_clock::now();
+    bool ok = maze.validate_maze_path();
+    double validate_ms = elapsed_ms(start);
+    std::cout << "validate reachable=" << (ok ? "yes" : "no") << " time_ms=" << validate_ms << std::endl;
+    print_cache_stats(maze);
+    return ok ? 0 : 2;
+}
+
+// 沿求得的路径逐格给出方向输入的自动驾驶输入源
+static InputSource path_follower(const std::vector<Coordinate>& path) {
+    return [&path, next = size_t(1)](const PlayerSim& sim) mutable {
+        Coordinate c = sim.get_coord();
+        while (next < path.size() && !(path[next - 1] == c)) ++next; // 跳过已走过的格
+        if (next >= path.size()) return MoveInput::NONE;
+        Coordinate t = path[next];
+        if (t.y > c.y) return MoveInput::DOWN;
+        if (t.x < c.x) return MoveInput::LEFT;
+        if (t.x > c.x) return MoveInput::RIGHT;
+        if (t.y < c.y) return MoveInput::UP;
+        return MoveInput::NONE;
+    };
+}
+
+static int run_sim(int argc, char** argv) {
+    if (argc < 3) {
+        print_usage();
+        return 1;
+    }
+    PathType type = PathType::BFS;
+    uint64_t max_ticks = UINT64_MAX;
+    std::string record_path;
+    for (int i = 3; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--algo") == 0 && i + 1 < argc && parse_algo(argv[i + 1], type)) {
+            ++i;
+        }
+        else if (std::strcmp(argv[i], "--max-ticks") == 0 && i + 1 < argc) {
+            max_ticks = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            record_path = argv[++i];
+        }
+        else {
+            print_usage();
+            return 1;
+        }
+    }
+
+    MazeCore maze(argv[2]);
+    if (maze.get_rows() == 0) return 1;
+    const std::vector<Coordinate>& path = maze.compute_path(type);
+
+    // 无窗口按固定步长连续推进，输入由路径自动给出
+    PlayerSim sim(maze);
+    InputRecorder recorder;
+    InputSource follow = path_follower(path);
+    InputSource input = follow;
+    if (!record_path.empty()) {
+        input = [&follow, &recorder](const PlayerSim& s) {
+            MoveInput m = follow(s);
+            recorder.record(s.get_ticks(), m);
+            return m;
+        };
+    }
+    auto start = std::chrono::steady_clock::now();
+    uint64_t ticks = sim.run(input, max_ticks);
+    double sim_ms = elapsed_ms(start);
+    std::cout << "sim algo=" << algo_name(type) << " ticks=" << ticks
+        << " game_time_s=" << static_cast<double>(ticks) / SIM_TICK_RATE
+        << " score=" << sim.get_score() << " win=" << (sim.is_win_state() ? "yes" : "no")
+        << " dead=" << (sim.is_dead_state() ? "yes" : "no") << " time_ms=" << sim_ms
+        << " ticks_per_s=" << (sim_ms > 0 ? ticks / sim_ms * 1000.0 : 0.0) << std::endl;
+
+    if (!record_path.empty()) {
+        ReplayLog log;
+        log.maze_file = argv[2];
+        log.events = recorder.get_events();
+        log.result = sim_result(sim);
+        if (!save_replay(log, record_path)) return 1;
+    }
+    return sim.is_win_state() ? 0 : 2;
+}
+
+// 批量校验录像：同一迷宫只构造一次，逐个回放并与记录的结果比对
+static int run_replay_check(int argc, char** argv) {
+    std::vector<std::string> files;
+    int repeat = 1;
+    for (int i = 2; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        }
+        else {
+            files.push_back(argv[i]);
+        }
+    }
+    if (files.empty()) {
+        print_usage();
+        return 1;
+    }
+
+    std::vector<ReplayLog> logs(files.size());
+    for (size_t i = 0; i < files.size(); ++i) {
+        if (!load_replay(files[i], logs[i])) return 1;
+    }
+
+    std::map<std::string, std::unique_ptr<MazeCore>> mazes;
+    auto maze_for = [&mazes](const ReplayLog& log) -> const MazeCore& {
+        std::string key = log.maze_file.empty()
+            ? "random " + std::to_string(log.rows) + " " + std::to_string(log.cols) + " " + std::to_string(log.seed)
+            : "file " + log.maze_file;
+        auto& maze = mazes[key];
+        if (!maze) maze = std::make_unique<MazeCore>(log.build_maze());
+        return *maze;
+    };
+
+    size_t mismatched = 0;
+    uint64_t total_ticks = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeat; ++r) {
+        for (size_t i = 0; i < logs.size(); ++i) {
+            ReplayResult result = run_replay(maze_for(logs[i]), logs[i]);
+            total_ticks += result.ticks;
+            if (result == logs[i].result) continue;
+            ++mismatched;
+            if (r == 0) {
+                std::cout << "mismatch file=" << files[i] << " recorded_score=" << logs[i].result.score
+                    << " replayed_score=" << result.score << " recorded_ticks=" << logs[i].result.ticks
+                    << " replayed_ticks=" << result.ticks << std::endl;
+            }
+        }
+    }
+    double replay_ms = elapsed_ms(start);
+    size_t total = logs.size() * repeat;
+    std::cout << "replay count=" << total << " ok=" << (total - mismatched) << " mismatched=" << mismatched
+        << " ticks=" << total_ticks << " time_ms=" << replay_ms
+        << " replays_per_s=" << (replay_ms > 0 ? total / replay_ms * 1000.0 : 0.0) << std::endl;
+    return mismatched == 0 ? 0 : 2;
+}
+
+// 到终点的距离场：一次反向搜索的耗时，以及从任意格读出路线的耗时与正确性
+static int run_hint(int argc, char** argv) {
+    if (argc < 3) {
+        print_usage();
+        return 1;
+    }
+    int samples = 1000;
+    uint32_t seed = 1;
+    for (int i = 3; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+            samples = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else {
+            print_usage();
+            return 1;
+        }
+    }
+
+    MazeCore maze(argv[2]);
+    if (maze.get_rows() == 0) return 1;
+
+    auto start = std::chrono::steady_clock::now();
+    maze.compute_exit_field();
+    double field_ms = elapsed_ms(start);
+
+    // 从起点读出的代价应与正向Dijkstra一致
+    int dijkstra_cost = maze.get_path_cost(maze.compute_path(PathType::DIJKSTRA));
+    int field_cost = maze.get_cost_to_exit(maze.get_start_coord());
+    std::cout << "field time_ms=" << field_ms << " start_cost=" << field_cost
+        << " dijkstra_cost=" << dijkstra_cost << std::endl;
+    bool ok = field_cost == dijkstra_cost;
+
+    // 随机取可达格读出路线，路线代价须等于场中记录的代价
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> rand_x(0, maze.get_cols() - 1), rand_y(0, maze.get_rows() - 1);
+    int routed = 0, mismatched = 0;
+    size_t total_length = 0;
+    double route_ms = 0;
+    for (int attempt = 0; routed < samples && attempt < samples * 100; ++attempt) {
+        Coordinate from = { rand_x(rng), rand_y(rng) };
+        int cost = maze.get_cost_to_exit(from);
+        if (cost < 0) continue;
+        start = std::chrono::steady_clock::now();
+        std::vector<Coordinate> route = maze.route_to_exit(from);
+        route_ms += elapsed_ms(start);
+        if (route.empty() || !(route.back() == maze.get_end_coord()) || maze.get_path_cost(route) != cost) ++mismatched;
+        total_length += route.size();
+        ++routed;
+    }
+    std::cout << "routes n=" << routed << " mismatched=" << mismatched
+        << " avg_length=" << (routed > 0 ? static_cast<double>(total_length) / routed : 0.0)
+        << " avg_us=" << (routed > 0 ? route_ms * 1000.0 / routed : 0.0) << std::endl;
+    return ok && mismatched == 0 ? 0 : 2;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        print_usage();
+        return 1;
+    }
+
+    std::string command = argv[1];
+    if (command == "gen") return run_gen(argc, argv);
+    if (command == "stream") return run_stream(argc, argv);
+    if (command == "convert") return run_convert(argc, argv);
+    if (command == "solve") return run_solve(argc, argv);
+    if (command == "validate") return run_validate(argc, argv);
+    if (command == "sim") return run_sim(argc, argv);
+    if (command == "replay") return run_replay_check(argc, argv);
+    if (command == "hint") return run_hint(argc, argv);
+
+    print_usage();
+    return 1;
+}
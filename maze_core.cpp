@@ -0,0 +1,909 @@
+#include "maze_core.h"
+#include <fstream>
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <charconv>
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <stack>
+#include <queue>
+#include <deque>
+#include <tuple>
+
+// ؿ۲ֵʱDijkstraĬʹͰ
+static const int BUCKET_QUEUE_MAX_COST = 64;
+
+bool Coordinate::operator==(const Coordinate& other) const {
+    return x == other.x && y == other.y;
+}
+
+size_t std::hash<Coordinate>::operator()(const Coordinate& c) const {
+    return hash<int>()(c.x) ^ (hash<int>()(c.y) << 1);
+}
+
+bool MazeCore::is_valid(Coordinate c) const {
+    if (c.x < 0 || c.x >= cols || c.y < 0 || c.y >= rows) return false;
+    TileType type = tile_at(c.x, c.y);
+    return type != TileType::WALL && type != TileType::LAVA;
+}
+
+std::vector<Coordinate> MazeCore::get_neighbors(Coordinate c) const {
+    std::vector<Coordinate> neighbors;
+    if (is_valid({ c.x, c.y - 1 })) neighbors.push_back({ c.x, c.y - 1 }); // 
+    if (is_valid({ c.x, c.y + 1 })) neighbors.push_back({ c.x, c.y + 1 }); // 
+    if (is_valid({ c.x - 1, c.y })) neighbors.push_back({ c.x - 1, c.y }); // 
+    if (is_valid({ c.x + 1, c.y })) neighbors.push_back({ c.x + 1, c.y }); // 
+    return neighbors;
+}
+
+bool MazeCore::validate_maze_path() const {
+    if (bfs_mode == BfsMode::QUEUE) {
+        return validate_queue();
+    }
+    return validate_bitset();
+}
+
+bool MazeCore::validate_queue() const {
+    std::vector<std::vector<bool>> visited(rows, std::vector<bool>(cols, false));
+    std::queue<Coordinate> q;
+    q.push(start_coord);
+    visited[start_coord.y][start_coord.x] = true;
+
+    while (!q.empty()) {
+        Coordinate curr = q.front();
+        q.pop();
+
+        if (curr == end_coord) return true;
+
+        for (auto& neighbor : get_neighbors(curr)) {
+            if (!visited[neighbor.y][neighbor.x]) {
+                visited[neighbor.y][neighbor.x] = true;
+                q.push(neighbor);
+            }
+        }
+    }
+    return false;
+}
+
+void MazeCore::compute_dfs_path() {
+    dfs_path.clear();
+
+    // ÿֻ¼ķ1ֽڣջʱȷǰҵյͳһ·
+    std::vector<uint8_t> from_dir(cell_count(), DIR_NONE);
+
+    struct DfsNode {
+        Coordinate coord;
+        uint8_t dir; // ǰߵøķ
+    };
+    std::stack<DfsNode, std::vector<DfsNode>> s;
+    s.push({ start_coord, DIR_ROOT });
+
+    bool found = false;
+    size_t expanded = 0;
+    while (!s.empty()) {
+        DfsNode node = s.top();
+        s.pop();
+        Coordinate curr = node.coord;
+
+        if (curr == end_coord) {
+            from_dir[tile_index(curr.x, curr.y)] = node.dir;
+            found = true;
+            break;
+        }
+        uint8_t& visited_dir = from_dir[tile_index(curr.x, curr.y)];
+        if (visited_dir != DIR_NONE) continue;
+        visited_dir = node.dir;
+        ++expanded;
+
+        // ѹջҡ¡ϣ֤ջ˳get_neighborsһ
+        for (int d = 3; d >= 0; --d) {
+            Coordinate neighbor = { curr.x + DIR_DX[d], curr.y + DIR_DY[d] };
+            if (is_valid(neighbor) && from_dir[tile_index(neighbor.x, neighbor.y)] == DIR_NONE) {
+                s.push({ neighbor, static_cast<uint8_t>(d) });
+            }
+        }
+    }
+    expanded_nodes[PathType::DFS] = expanded;
+    if (found) {
+        dfs_path = trace_path(from_dir, end_coord);
+    }
+}
+
+void MazeCore::compute_bfs_path() {
+    if (bfs_mode == BfsMode::BITSET) {
+        compute_bfs_bitset();
+    }
+    else {
+        compute_bfs_queue();
+    }
+}
+
+void MazeCore::compute_bfs_queue() {
+    bfs_path.clear();
+    std::vector<std::vector<bool>> visited(rows, std::vector<bool>(cols, false));
+    std::vector<std::vector<Coordinate>> prev(rows, std::vector<Coordinate>(cols, { -1, -1 }));
+    std::queue<Coordinate> q;
+
+    q.push(start_coord);
+    visited[start_coord.y][start_coord.x] = true;
+    size_t expanded = 0;
+
+    while (!q.empty()) {
+        Coordinate curr = q.front();
+        q.pop();
+
+        if (curr == end_coord) break;
+        ++expanded;
+
+        for (auto& neighbor : get_neighbors(curr)) {
+            if (!visited[neighbor.y][neighbor.x]) {
+                visited[neighbor.y][neighbor.x] = true;
+                prev[neighbor.y][neighbor.x] = curr;
+                q.push(neighbor);
+            }
+        }
+    }
+    expanded_nodes[PathType::BFS] = expanded;
+
+    // ·
+    Coordinate curr = end_coord;
+    while (curr.x != -1 && curr.y != -1) {
+        bfs_path.push_back(curr);
+        curr = prev[curr.y][curr.x];
+    }
+    std::reverse(bfs_path.begin(), bfs_path.end());
+}
+
+int MazeCore::get_tile_cost(TileType type) const {
+    return (type == TileType::GRASS) ? 3 : 1;
+}
+
+int MazeCore::get_min_tile_cost() const {
+    // ֻͳƿͨеؿ飨ǽҲɽ룩
+    return std::min({
+        get_tile_cost(TileType::FLOOR),
+        get_tile_cost(TileType::GRASS),
+        get_tile_cost(TileType::START),
+        get_tile_cost(TileType::END)
+    });
+}
+
+int MazeCore::get_max_tile_cost() const {
+    return std::max({
+        get_tile_cost(TileType::FLOOR),
+        get_tile_cost(TileType::GRASS),
+        get_tile_cost(TileType::START),
+        get_tile_cost(TileType::END)
+    });
+}
+
+void MazeCore::set_dijkstra_queue(DijkstraQueue queue) {
+    dijkstra_queue = queue;
+}
+
+void MazeCore::set_bfs_mode(BfsMode mode) {
+    bfs_mode = mode;
+}
+
+void MazeCore::compute_dijkstra_path() {
+    if (incremental_planning && compute_incremental_path()) return;
+
+    bool use_bucket = dijkstra_queue == DijkstraQueue::BUCKET
+        || (dijkstra_queue == DijkstraQueue::AUTO && get_max_tile_cost() <= BUCKET_QUEUE_MAX_COST);
+    if (use_bucket) {
+        compute_dijkstra_bucket();
+    }
+    else {
+        compute_dijkstra_heap();
+    }
+}
+
+void MazeCore::compute_dijkstra_heap() {
+    dijkstra_path.clear();
+    const int INF = INT_MAX;
+    std::vector<std::vector<int>> dist(rows, std::vector<int>(cols, INF));
+    std::vector<std::vector<Coordinate>> prev(rows, std::vector<Coordinate>(cols, { -1, -1 }));
+    using PriorityNode = std::tuple<int, int, int>;
+    std::priority_queue<PriorityNode, std::vector<PriorityNode>, std::greater<>> pq;
+
+    dist[start_coord.y][start_coord.x] = 0;
+    pq.emplace(0, start_coord.x, start_coord.y);
+    size_t expanded = 0;
+
+    while (!pq.empty()) {
+        auto [cost, x, y] = pq.top();
+        pq.pop();
+        Coordinate curr = { x, y };
+
+        if (curr == end_coord) break;
+        if (cost > dist[y][x]) continue;
+        ++expanded;
+
+        for (auto& neighbor : get_neighbors(curr)) {
+            int nx = neighbor.x, ny = neighbor.y;
+            int new_cost = cost + get_tile_cost(get_tile_type(neighbor));
+            if (new_cost < dist[ny][nx]) {
+                dist[ny][nx] = new_cost;
+                prev[ny][nx] = curr;
+                pq.emplace(new_cost, nx, ny);
+            }
+        }
+    }
+
+    expanded_nodes[PathType::DIJKSTRA] = expanded;
+
+    // ·
+    Coordinate curr = end_coord;
+    while (curr.x != -1 && curr.y != -1) {
+        dijkstra_path.push_back(curr);
+        curr = prev[curr.y][curr.x];
+    }
+    std::reverse(dijkstra_path.begin(), dijkstra_path.end());
+}
+
+void MazeCore::compute_dijkstra_bucket() {
+    dijkstra_path.clear();
+    const int INF = INT_MAX;
+    std::vector<int> dist(cell_count(), INF);
+    std::vector<uint8_t> from_dir(cell_count(), DIR_NONE);
+
+    // ͰУDial㷨Ȩmax_costʱڵľ붼[d, d + max_cost]ڣ
+    // max_cost + 1ͰѭʹüɣӳӾΪO(1)
+    const int max_cost = get_max_tile_cost();
+    const int bucket_count = max_cost + 1;
+    std::vector<std::vector<size_t>> buckets(bucket_count);
+    size_t queued = 0;
+
+    size_t start_idx = tile_index(start_coord.x, start_coord.y);
+    size_t end_idx = tile_index(end_coord.x, end_coord.y);
+    dist[start_idx] = 0;
+    from_dir[start_idx] = DIR_ROOT;
+    buckets[0].push_back(start_idx);
+    queued = 1;
+    size_t expanded = 0;
+
+    for (int cost = 0; queued > 0; ++cost) {
+        std::vector<size_t>& bucket = buckets[cost % bucket_count];
+        bool reached_end = false;
+        while (!bucket.empty()) {
+            size_t idx = bucket.back();
+            bucket.pop_back();
+            --queued;
+
+            if (dist[idx] != cost) continue; // ѱ̾ȡľɼ¼
+            if (idx == end_idx) {
+                reached_end = true;
+                break;
+            }
+            ++expanded;
+
+            int x = static_cast<int>(idx % cols);
+            int y = static_cast<int>(idx / cols);
+            for (int d = 0; d < 4; ++d) {
+                Coordinate neighbor = { x + DIR_DX[d], y + DIR_DY[d] };
+                if (!is_valid(neighbor)) continue;
+                size_t n_idx = tile_index(neighbor.x, neighbor.y);
+                int new_cost = cost + get_tile_cost(tile_at(neighbor.x, neighbor.y));
+                if (new_cost < dist[n_idx]) {
+                    dist[n_idx] = new_cost;
+                    from_dir[n_idx] = static_cast<uint8_t>(d);
+                    buckets[new_cost % bucket_count].push_back(n_idx);
+                    ++queued;
+                }
+            }
+        }
+        if (reached_end) break;
+    }
+
+    expanded_nodes[PathType::DIJKSTRA] = expanded;
+    dijkstra_path = trace_path(from_dir, end_coord);
+}
+
+void MazeCore::compute_astar_path() {
+    astar_path.clear();
+    const int INF = INT_MAX;
+    std::vector<int> dist(cell_count(), INF);
+    std::vector<uint8_t> from_dir(cell_count(), DIR_NONE);
+
+    // پСؿۣ߹ʣۣ֤
+    const int min_cost = get_min_tile_cost();
+    auto heuristic = [&](int x, int y) {
+        return (std::abs(x - end_coord.x) + std::abs(y - end_coord.y)) * min_cost;
+    };
+
+    // (f, h, x, y)fͬʱչյĽڵ
+    using PriorityNode = std::tuple<int, int, int, int>;
+    std::priority_queue<PriorityNode, std::vector<PriorityNode>, std::greater<>> pq;
+
+    dist[tile_index(start_coord.x, start_coord.y)] = 0;
+    from_dir[tile_index(start_coord.x, start_coord.y)] = DIR_ROOT;
+    pq.emplace(heuristic(start_coord.x, start_coord.y), heuristic(start_coord.x, start_coord.y), start_coord.x, start_coord.y);
+    size_t expanded = 0;
+    bool found = false;
+
+    while (!pq.empty()) {
+        auto [f, h, x, y] = pq.top();
+        pq.pop();
+        Coordinate curr = { x, y };
+
+        if (curr == end_coord) {
+            found = true;
+            break;
+        }
+        int cost = f - h;
+        if (cost > dist[tile_index(x, y)]) continue;
+        ++expanded;
+
+        for (int d = 0; d < 4; ++d) {
+            Coordinate neighbor = { x + DIR_DX[d], y + DIR_DY[d] };
+            if (!is_valid(neighbor)) continue;
+            size_t idx = tile_index(neighbor.x, neighbor.y);
+            int new_cost = cost + get_tile_cost(tile_at(neighbor.x, neighbor.y));
+            if (new_cost < dist[idx]) {
+                dist[idx] = new_cost;
+                from_dir[idx] = static_cast<uint8_t>(d);
+                int nh = heuristic(neighbor.x, neighbor.y);
+                pq.emplace(new_cost + nh, nh, neighbor.x, neighbor.y);
+            }
+        }
+    }
+    expanded_nodes[PathType::ASTAR] = expanded;
+    if (found) {
+        astar_path = trace_path(from_dir, end_coord);
+    }
+}
+
+std::vector<Coordinate> MazeCore::trace_path(const std::vector<uint8_t>& from_dir, Coordinate tail) const {
+    std::vector<Coordinate> path;
+    Coordinate curr = tail;
+    while (true) {
+        path.push_back(curr);
+        uint8_t d = from_dir[tile_index(curr.x, curr.y)];
+        if (d == DIR_ROOT || d == DIR_NONE) break;
+        curr = { curr.x - DIR_DX[d], curr.y - DIR_DY[d] };
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+void MazeCore::load_maze(const std::string& filepath) {
+    // ļӳ䵽ڴֱڻϽifstreamȡ
+    MappedFile file(filepath);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open maze file!" << std::endl;
+        return;
+    }
+
+    // ħֶƸʽıʽֿļ룬Ϊҳ
+    if (file.size() >= sizeof(MAZE_FILE_MAGIC) && std::memcmp(file.data(), MAZE_FILE_MAGIC, sizeof(MAZE_FILE_MAGIC)) == 0) {
+        if (file.size() >= sizeof(MazeFileHeader)
+            && file.data()[offsetof(MazeFileHeader, encoding)] == MAZE_ENCODING_CHUNKED) {
+            load_chunked_maze(filepath);
+        }
+        else {
+            load_binary_maze(file.data(), file.size());
+        }
+    }
+    else {
+        load_text_maze(reinterpret_cast<const char*>(file.data()), file.size());
+    }
+}
+
+void MazeCore::load_text_maze(const char* data, size_t size) {
+    const char* p = data;
+    const char* end = data + size;
+    // հ׺from_charsһlocaleӰ죬״̬
+    auto next_int = [&](int& value) {
+        while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) ++p;
+        auto [ptr, ec] = std::from_chars(p, end, value);
+        if (ec != std::errc()) return false;
+        p = ptr;
+        return true;
+    };
+
+    int file_rows = 0, file_cols = 0;
+    if (!next_int(file_rows) || !next_int(file_cols) || file_rows <= 0 || file_cols <= 0) {
+        std::cerr << "Invalid maze file header!" << std::endl;
+        reset_grid();
+        return;
+    }
+    rows = file_rows;
+    cols = file_cols;
+    tiles.assign(static_cast<size_t>(rows) * cols, static_cast<uint8_t>(TileType::WALL));
+
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            int tile_val;
+            if (!next_int(tile_val)) {
+                std::cerr << "Maze file truncated at row " << r << ", col " << c << std::endl;
+                reset_grid();
+                return;
+            }
+
+            TileType type = static_cast<TileType>(tile_val);
+            set_tile(c, r, type);
+
+            if (type == TileType::START) {
+                start_coord = { c, r };
+            }
+            else if (type == TileType::END) {
+                end_coord = { c, r };
+            }
+        }
+    }
+}
+
+void MazeCore::load_binary_maze(const uint8_t* data, size_t size) {
+    MazeFileHeader header = {};
+    if (size < sizeof(header)) {
+        std::cerr << "Invalid binary maze file!" << std::endl;
+        return;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (header.version != MAZE_FILE_VERSION || header.rows <= 0 || header.cols <= 0
+        || (header.encoding != MAZE_ENCODING_NIBBLE && header.encoding != MAZE_ENCODING_BYTE)) {
+        std::cerr << "Invalid binary maze file!" << std::endl;
+        return;
+    }
+
+    const size_t row_bytes = (header.encoding == MAZE_ENCODING_BYTE)
+        ? static_cast<size_t>(header.cols)
+        : (static_cast<size_t>(header.cols) + 1) / 2;
+    const size_t body_size = row_bytes * header.rows;
+    const uint8_t* body = data + sizeof(header);
+    if (size - sizeof(header) < body_size) {
+        std::cerr << "Binary maze file truncated!" << std::endl;
+        return;
+    }
+    MazeChecksum checksum;
+    checksum.update(body, body_size);
+    if (checksum.finish() != header.checksum) {
+        std::cerr << "Binary maze file checksum mismatch!" << std::endl;
+        return;
+    }
+
+    std::vector<uint8_t> grid;
+    if (header.encoding == MAZE_ENCODING_BYTE) {
+        // ÿ1ֽڴ沼ͬ鿽
+        grid.assign(body, body + body_size);
+    }
+    else {
+        // ÿ4λֽڲһν
+        uint8_t decode_table[256][2];
+        for (int b = 0; b < 256; ++b) {
+            decode_table[b][0] = decode_tile_nibble(b & 0x0F);
+            decode_table[b][1] = decode_tile_nibble(b >> 4);
+        }
+        grid.resize(static_cast<size_t>(header.rows) * header.cols);
+        for (int r = 0; r < header.rows; ++r) {
+            const uint8_t* in = body + static_cast<size_t>(r) * row_bytes;
+            uint8_t* out = grid.data() + static_cast<size_t>(r) * header.cols;
+            int c = 0;
+            for (; c + 1 < header.cols; c += 2) {
+                const uint8_t* pair = decode_table[in[c / 2]];
+                out[c] = pair[0];
+                out[c + 1] = pair[1];
+            }
+            if (c < header.cols) {
+                out[c] = decode_table[in[c / 2]][0];
+            }
+        }
+    }
+
+    rows = header.rows;
+    cols = header.cols;
+    tiles = std::move(grid);
+    start_coord = { header.start_x, header.start_y };
+    end_coord = { header.end_x, header.end_y };
+    if (!endpoints_valid()) {
+        std::cerr << "Binary maze file has invalid start/end!" << std::endl;
+        reset_grid();
+    }
+}
+
+void MazeCore::load_chunked_maze(const std::string& filepath) {
+    auto store = std::make_unique<ChunkedTileStore>(filepath, chunk_cache_bytes);
+    if (!store->is_open()) return;
+
+    const MazeFileHeader& header = store->get_header();
+    rows = header.rows;
+    cols = header.cols;
+    start_coord = { header.start_x, header.start_y };
+    end_coord = { header.end_x, header.end_y };
+    tiles.clear();
+    chunk_store = std::move(store);
+    if (!endpoints_valid()) {
+        std::cerr << "Chunked maze file has invalid start/end!" << std::endl;
+        reset_grid();
+    }
+}
+
+bool MazeCore::endpoints_valid() const {
+    for (Coordinate c : { start_coord, end_coord }) {
+        if (c.x < 0 || c.x >= cols || c.y < 0 || c.y >= rows) return false;
+        if (tile_at(c.x, c.y) == TileType::WALL) return false;
+    }
+    return true;
+}
+
+void MazeCore::reset_grid() {
+    rows = cols = 0;
+    tiles.clear();
+    chunk_store.reset();
+    start_coord = { 0, 0 };
+    end_coord = { 0, 0 };
+}
+
+const uint8_t* MazeCore::tile_row(int y, std::vector<uint8_t>& scratch) const {
+    if (!chunk_store) return tiles.data() + tile_index(0, y);
+    scratch.resize(cols);
+    chunk_store->read_row(y, 0, cols, scratch.data());
+    return scratch.data();
+}
+
+void MazeCore::generate_random_maze(int rows_, int cols_, uint32_t seed) {
+    // 1. ǿԹߴΪ
+    rows = (rows_ % 2 == 0) ? rows_ + 1 : rows_;
+    cols = (cols_ % 2 == 0) ? cols_ + 1 : cols_;
+
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> dir_dist(0, 3); // 
+
+    // 2. ʼλΪǽ
+    tiles.assign(static_cast<size_t>(rows) * cols, static_cast<uint8_t>(TileType::WALL));
+
+    // 3. ԪṹԪ(2i+1,2j+1)ǽżλ
+    using Cell = std::pair<int, int>;
+    std::vector<std::vector<bool>> visited((rows - 1) / 2, std::vector<bool>((cols - 1) / 2, false));
+    std::stack<Cell> stack;
+
+    // 㵥Ԫ񣨶ӦԹ(1,1)
+    Cell start_cell = { 0, 0 };
+    stack.push(start_cell);
+    visited[start_cell.first][start_cell.second] = true;
+    int visited_cells = 1;
+    int total_cells = ((rows - 1) / 2) * ((cols - 1) / 2); // ܵԪ
+    const int progress_step = std::max(total_cells / 100, 1); // Լÿ1%㱨һν
+
+    // 4. DFSԹ
+    while (visited_cells < total_cells) {
+        Cell curr = stack.top();
+        int i = curr.first;
+        int j = curr.second;
+        std::vector<std::pair<Cell, Cell>> neighbors;
+
+        // ھ
+        if (i > 0 && !visited[i - 1][j]) {
+            neighbors.push_back({ {i - 1, j}, {2 * i, 2 * j + 1} });
+        }
+        // ھ
+        if (i < (rows - 1) / 2 - 1 && !visited[i + 1][j]) {
+            neighbors.push_back({ {i + 1, j}, {2 * (i + 1), 2 * j + 1} });
+        }
+        // ھ
+        if (j > 0 && !visited[i][j - 1]) {
+            neighbors.push_back({ {i, j - 1}, {2 * i + 1, 2 * j} });
+        }
+        // ھ
+        if (j < (cols - 1) / 2 - 1 && !visited[i][j + 1]) {
+            neighbors.push_back({ {i, j + 1}, {2 * i + 1, 2 * (j + 1)} });
+        }
+
+        if (!neighbors.empty()) {
+            // ѡھ
+            auto [next_cell, wall_pos] = neighbors[dir_dist(gen) % neighbors.size()];
+            int wall_x = wall_pos.second;
+            int wall_y = wall_pos.first;
+            int cell_x = 2 * next_cell.second + 1;
+            int cell_y = 2 * next_cell.first + 1;
+
+            // ͨǽΪذ壩
+            set_tile(wall_x, wall_y, TileType::FLOOR);
+            // Ŀ굥ԪΪذ
+            set_tile(cell_x, cell_y, TileType::FLOOR);
+
+            // һԪ
+            visited[next_cell.first][next_cell.second] = true;
+            stack.push(next_cell);
+            visited_cells++;
+            if (visited_cells % progress_step == 0) {
+                report_progress(0.9f * visited_cells / total_cells); // ԼռųɣΪװ޸
+            }
+        }
+        else {
+            stack.pop();
+        }
+    }
+
+    decorate_maze(gen);
+}
+
+void MazeCore::decorate_maze(std::mt19937& gen) {
+    std::uniform_int_distribution<> type_dist(0, 19); // ؿ͸
+
+    // 5. յ
+    start_coord = { 1, 1 };
+    set_tile(start_coord.x, start_coord.y, TileType::START);
+    end_coord = { cols - 2, rows - 2 };
+    set_tile(end_coord.x, end_coord.y, TileType::END);
+
+    // 6. Ӳݵ/
+    std::vector<Coordinate> all_floors;
+    for (int y = 1; y < rows - 1; y += 2) { // Ԫλ
+        for (int x = 1; x < cols - 1; x += 2) {
+            Coordinate c = { x, y };
+            if (tile_at(x, y) == TileType::FLOOR) {
+                all_floors.push_back(c);
+            }
+        }
+    }
+
+    // ޸ĵذΪݵ/
+    std::shuffle(all_floors.begin(), all_floors.end(), gen);
+    int modify_count = std::min((int)all_floors.size() / 3, 30);
+    for (int i = 0; i < modify_count; ++i) {
+        Coordinate c = all_floors[i];
+        int rand_type = type_dist(gen);
+        if (rand_type < 15) { // 75% ݵ
+            set_tile(c.x, c.y, TileType::GRASS);
+        }
+        else if (rand_type < 18) { // 15% ֵذ
+            set_tile(c.x, c.y, TileType::FLOOR);
+        }
+        else { // 10% 
+            set_tile(c.x, c.y, TileType::LAVA);
+        }
+    }
+
+    // 7. У·Чԣ޸
+    repair_lava_path();
+    report_progress(1.0f);
+}
+
+int MazeCore::repair_lava_path() {
+    // 0-1 BFSҴΪ1ͨеؿΪ0ǽͨ
+    // յ·ٵ·ߣֻ·ϵҸΪذ壬
+    // һɨ輴ɱ֤ͨͨʱ·ûңκ޸ģ
+    const int INF = INT_MAX;
+    std::vector<int> dist(cell_count(), INF);
+    std::vector<uint8_t> from_dir(cell_count(), DIR_NONE);
+    std::deque<size_t> dq;
+
+    size_t start_idx = tile_index(start_coord.x, start_coord.y);
+    size_t end_idx = tile_index(end_coord.x, end_coord.y);
+    dist[start_idx] = 0;
+    from_dir[start_idx] = DIR_ROOT;
+    dq.push_back(start_idx);
+
+    while (!dq.empty()) {
+        size_t idx = dq.front();
+        dq.pop_front();
+        if (idx == end_idx) break;
+
+        int x = static_cast<int>(idx % cols);
+        int y = static_cast<int>(idx / cols);
+        for (int d = 0; d < 4; ++d) {
+            int nx = x + DIR_DX[d], ny = y + DIR_DY[d];
+            if (nx < 0 || nx >= cols || ny < 0 || ny >= rows) continue;
+            TileType type = tile_at(nx, ny);
+            if (type == TileType::WALL) continue;
+            size_t n_idx = tile_index(nx, ny);
+            int weight = (type == TileType::LAVA) ? 1 : 0;
+            if (dist[idx] + weight < dist[n_idx]) {
+                dist[n_idx] = dist[idx] + weight;
+                from_dir[n_idx] = static_cast<uint8_t>(d);
+                if (weight == 0) {
+                    dq.push_front(n_idx);
+                }
+                else {
+                    dq.push_back(n_idx);
+                }
+            }
+        }
+    }
+
+    if (dist[end_idx] == INF) return 0; // ǽϣ޸޼
+    int converted = 0;
+    for (const auto& c : trace_path(from_dir, end_coord)) {
+        if (tile_at(c.x, c.y) == TileType::LAVA) {
+            set_tile(c.x, c.y, TileType::FLOOR);
+            ++converted;
+        }
+    }
+    return converted;
+}
+
+MazeCore::MazeCore(const std::string& filepath) {
+    load_maze(filepath);
+}
+
+MazeCore::MazeCore(const std::string& filepath, size_t chunk_cache_bytes_) : chunk_cache_bytes(chunk_cache_bytes_) {
+    load_maze(filepath);
+}
+
+MazeCore::MazeCore(int rows, int cols) : MazeCore(rows, cols, std::random_device{}()) {}
+
+MazeCore::MazeCore(int rows, int cols, uint32_t seed) {
+    generate_random_maze(rows, cols, seed);
+}
+
+MazeCore::MazeCore(int rows, int cols, uint32_t seed, int threads) {
+    generate_tiled_maze(rows, cols, seed, threads);
+}
+
+MazeCore::MazeCore(int rows, int cols, uint32_t seed, ProgressCallback progress) : on_progress(std::move(progress)) {
+    generate_random_maze(rows, cols, seed);
+    on_progress = nullptr; // صõ÷ʱ״̬ɽٳ
+}
+
+// 㷨ÿ״ֽ̬жʵʱϴ߹
+// BFSаDijkstraѰжάǰ꣬Ѱ·Ϊg/rhsۡ·ǣ
+static size_t solver_bytes_per_cell(PathType type) {
+    switch (type) {
+    case PathType::DFS: return 1;
+    case PathType::BFS: return 9;
+    case PathType::DIJKSTRA: return 12;
+    case PathType::ASTAR: return 5;
+    case PathType::BIDIRECTIONAL_BFS:
+    case PathType::BIDIRECTIONAL_DIJKSTRA: return 10;
+    default: return 0;
+    }
+}
+
+bool MazeCore::solver_state_fits(size_t bytes_per_cell, const char* what) const {
+    if (!chunk_store) return true;
+    size_t bytes = cell_count() * bytes_per_cell;
+    if (bytes <= solver_state_limit) return true;
+    std::cerr << what << " on chunked maze needs about " << (bytes >> 20) << " MB of solver state, over the limit of "
+        << (solver_state_limit >> 20) << " MB; skipped" << std::endl;
+    return false;
+}
+
+void MazeCore::set_solver_state_limit(size_t bytes) {
+    solver_state_limit = bytes;
+}
+
+const std::vector<Coordinate>& MazeCore::compute_path(PathType type) {
+    if (!solver_state_fits(solver_bytes_per_cell(type), "Path search")) return get_path(type);
+    switch (type) {
+    case PathType::DFS:
+        compute_dfs_path();
+        break;
+    case PathType::BFS:
+        compute_bfs_path();
+        break;
+    case PathType::DIJKSTRA:
+        compute_dijkstra_path();
+        break;
+    case PathType::ASTAR:
+        compute_astar_path();
+        break;
+    case PathType::BIDIRECTIONAL_BFS:
+        compute_bidirectional_bfs_path();
+        break;
+    case PathType::BIDIRECTIONAL_DIJKSTRA:
+        compute_bidirectional_dijkstra_path();
+        break;
+    default: // NONE
+        return get_path(type);
+    }
+    computed_paths |= 1u << static_cast<int>(type);
+    return get_path(type);
+}
+
+void MazeCore::compute_all_paths() {
+    compute_path(PathType::DFS);
+    compute_path(PathType::BFS);
+    compute_path(PathType::DIJKSTRA);
+    compute_path(PathType::ASTAR);
+}
+
+void MazeCore::set_path(PathType type, std::vector<Coordinate> path) {
+    switch (type) {
+    case PathType::DFS:
+        dfs_path = std::move(path);
+        break;
+    case PathType::BFS:
+        bfs_path = std::move(path);
+        break;
+    case PathType::DIJKSTRA:
+        dijkstra_path = std::move(path);
+        break;
+    case PathType::ASTAR:
+        astar_path = std::move(path);
+        break;
+    case PathType::BIDIRECTIONAL_BFS:
+        bidirectional_bfs_path = std::move(path);
+        break;
+    case PathType::BIDIRECTIONAL_DIJKSTRA:
+        bidirectional_dijkstra_path = std::move(path);
+        break;
+    default: // NONE
+        return;
+    }
+    computed_paths |= 1u << static_cast<int>(type);
+}
+
+bool MazeCore::has_path(PathType type) const {
+    return type == PathType::NONE || (computed_paths & (1u << static_cast<int>(type))) != 0;
+}
+
+const std::vector<Coordinate>& MazeCore::get_path(PathType type) const {
+    static const std::vector<Coordinate> empty_path;
+    switch (type) {
+    case PathType::DFS:
+        return dfs_path;
+    case PathType::BFS:
+        return bfs_path;
+    case PathType::DIJKSTRA:
+        return dijkstra_path;
+    case PathType::ASTAR:
+        return astar_path;
+    case PathType::BIDIRECTIONAL_BFS:
+        return bidirectional_bfs_path;
+    case PathType::BIDIRECTIONAL_DIJKSTRA:
+        return bidirectional_dijkstra_path;
+    default: // NONE
+        return empty_path;
+    }
+}
+
+size_t MazeCore::get_expanded_nodes(PathType type) const {
+    auto it = expanded_nodes.find(type);
+    return it != expanded_nodes.end() ? it->second : 0;
+}
+
+int MazeCore::get_path_cost(const std::vector<Coordinate>& path) const {
+    int cost = 0;
+    for (size_t i = 1; i < path.size(); ++i) {
+        cost += get_tile_cost(get_tile_type(path[i]));
+    }
+    return cost;
+}
+
+bool MazeCore::save_maze(const std::string& filepath, MazeFileFormat format) const {
+    MazeFileWriter writer(filepath, rows, cols, format);
+    if (!writer.is_open()) return false;
+
+    std::vector<uint8_t> scratch;
+    for (int r = 0; r < rows; ++r) {
+        writer.write_row(tile_row(r, scratch));
+    }
+    return writer.finish(start_coord.x, start_coord.y, end_coord.x, end_coord.y);
+}
+
+Coordinate MazeCore::get_start_coord() const { return start_coord; }
+Coordinate MazeCore::get_end_coord() const { return end_coord; }
+TileType MazeCore::get_tile_type(const Coordinate& coord) const {
+    if (coord.y >= 0 && coord.y < rows && coord.x >= 0 && coord.x < cols) {
+        return tile_at(coord.x, coord.y);
+    }
+    return TileType::WALL;
+}
+
+bool MazeCore::can_set_tile(Coordinate c, TileType type) const {
+    if (c.x < 0 || c.x >= cols || c.y < 0 || c.y >= rows) return false;
+    if (c == start_coord || c == end_coord || type == TileType::START || type == TileType::END) return false;
+    return tile_at(c.x, c.y) != type;
+}
+
+bool MazeCore::set_tile_type(Coordinate c, TileType type) {
+    if (!can_set_tile(c, type)) return false;
+
+    set_tile(c.x, c.y, type);
+    ++grid_generation;
+    replan_after_edit(c);
+    return true;
+}
+
+uint64_t MazeCore::get_grid_generation() const { return grid_generation; }
+
+int MazeCore::get_rows() const { return rows; }
+int MazeCore::get_cols() const { return cols; }
+bool MazeCore::is_chunked() const { return chunk_store != nullptr; }
+ChunkCacheStats MazeCore::get_chunk_cache_stats() const {
+    return chunk_store ? chunk_store->get_stats() : ChunkCacheStats{};
+}
\ No newline at end of file
@@ -0,0 +1,318 @@
+#ifndef MAZE_CORE_H
+#define MAZE_CORE_H
+
+// ԹģɡУѰ·raylib޴ڻʹ
+#include <string>
+#include <vector>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <random>
+#include "bit_grid.h"
+#include "chunk_store.h"
+#include "incremental_planner.h"
+#include "maze_format.h"
+
+// ؿö٣ȡֵint8_tΧڣ1ֽڴ洢
+enum class TileType : int8_t {
+    END = -2,
+    START = -1,
+    FLOOR = 0,
+    WALL = 1,
+    GRASS = 2,
+    LAVA = 3
+};
+
+// ·ö٣ʾ·
+enum class PathType {
+    NONE,   // ʾ·
+    DFS,    // ·
+    BFS,    // ·
+    DIJKSTRA, // Dijkstra·
+    ASTAR,  // A*·
+    BIDIRECTIONAL_BFS,     // ˫BFS٣BFSȳ
+    BIDIRECTIONAL_DIJKSTRA // ˫DijkstraСDijkstraȼۣ
+};
+
+// ķƫƣ˳get_neighborsһ£ϡ¡
+const int DIR_DX[4] = { 0, 0, -1, 1 };
+const int DIR_DY[4] = { -1, 1, 0, 0 };
+
+// ǰȡֵδ / 
+const uint8_t DIR_NONE = 0xFF;
+const uint8_t DIR_ROOT = 4;
+
+// Dijkstraʹõȶʵ
+enum class DijkstraQueue {
+    AUTO,        // ؿ۽СʱͰУö
+    BINARY_HEAP, // std::priority_queueO(log n)ӳ
+    BUCKET       // ͰУDial㷨O(1)ӳ
+};
+
+// BFSͨУʵַʽ
+enum class BfsMode {
+    AUTO,   // ͨУλУBFS·öУԭ·һ£
+    QUEUE,  // 
+    BITSET  // ͨ԰64λִλ//չ߽
+};
+
+// ɽȻصΪɱ[0, 1]ڵ߳ϵã
+using ProgressCallback = std::function<void(float)>;
+
+// طֿԹļʱLRU黺ĬڴԤ
+const size_t DEFAULT_CHUNK_CACHE_BYTES = 64u << 20;
+
+// ֿԹѰ·볡״̬Ĭޣ黺ֻҳؿ鱾dist/ǰ
+// ԰ÿһͼ䣬㳬ʱܾ⣬ǷGBڴ
+const size_t DEFAULT_SOLVER_STATE_BYTES = 256u << 20;
+
+// ṹ
+struct Coordinate {
+    int x, y;
+    bool operator==(const Coordinate& other) const;
+};
+
+// Ϊӹϣunordered_map
+template<> struct std::hash<Coordinate> {
+    size_t operator()(const Coordinate& c) const;
+};
+
+// MazeCoreࣺԹݡɡ·УѰ·
+class MazeCore {
+protected:
+    std::vector<uint8_t> tiles; // 洢tiles[y * cols + x]Ϊؿͣ갴
+    std::unique_ptr<ChunkedTileStore> chunk_store; // طֿļʱǿգؿ龭LRU水룬tilesΪ
+    size_t chunk_cache_bytes = DEFAULT_CHUNK_CACHE_BYTES;
+    size_t solver_state_limit = DEFAULT_SOLVER_STATE_BYTES; // ֻԷֿ洢Ч
+    Coordinate start_coord = { 0, 0 };
+    Coordinate end_coord = { 0, 0 };
+    int rows = 0;
+    int cols = 0;
+
+    // ·洢
+    std::vector<Coordinate> dfs_path;
+    std::vector<Coordinate> bfs_path;
+    std::vector<Coordinate> dijkstra_path;
+    std::vector<Coordinate> astar_path;
+    std::vector<Coordinate> bidirectional_bfs_path;
+    std::vector<Coordinate> bidirectional_dijkstra_path;
+    std::map<PathType, size_t> expanded_nodes; // 㷨һչĽڵ
+    uint32_t computed_paths = 0; // н·ͣPathTypeȡֵλ룩
+
+    // յľ볡exit_distΪÿյСۣɴΪINT_MAX
+    // exit_dirΪøķ䷴һյ
+    std::vector<int> exit_dist;
+    std::vector<uint8_t> exit_dir;
+
+    // Ѱ·úcompute_path(DIJKSTRA)LPA*ֲ޸ϴεĽͼѡ
+    // 滮״ʱʱplanner_syncedʾdijkstra_pathȡԹ滮
+    // ޸չ޶ͼΪfalse´޸ʱȡ
+    bool incremental_planning = false;
+    std::unique_ptr<IncrementalPlanner> planner;
+    bool planner_synced = false;
+
+    // ʵֵѡ񣨼set_dijkstra_queueset_bfs_mode
+    DijkstraQueue dijkstra_queue = DijkstraQueue::AUTO;
+    BfsMode bfs_mode = BfsMode::AUTO;
+
+    uint64_t grid_generation = 0; // ÿ޸ĵؿ1̨ݴ˶ڵ
+    ProgressCallback on_progress; // ڼЧ
+
+    void report_progress(float fraction) const { if (on_progress) on_progress(fraction); }
+
+    // ֿ洢ʱ״̬ÿֽ˸Ƿڣʱ󲢷false
+    bool solver_state_fits(size_t bytes_per_cell, const char* what) const;
+
+    // ±ؿд÷֤ڽڣ
+    size_t cell_count() const { return static_cast<size_t>(rows) * cols; }
+    size_t tile_index(int x, int y) const { return static_cast<size_t>(y) * cols + x; }
+    TileType tile_at(int x, int y) const {
+        if (chunk_store) [[unlikely]] return static_cast<TileType>(static_cast<int8_t>(chunk_store->get(x, y)));
+        return static_cast<TileType>(static_cast<int8_t>(tiles[tile_index(x, y)]));
+    }
+    void set_tile(int x, int y, TileType type) {
+        if (chunk_store) [[unlikely]] chunk_store->set(x, y, static_cast<uint8_t>(type));
+        else tiles[tile_index(x, y)] = static_cast<uint8_t>(type);
+    }
+
+    // ȡyеĵؿ飺洢ʱֱӷָ룬ֿ洢ʱƵscratch
+    const uint8_t* tile_row(int y, std::vector<uint8_t>& scratch) const;
+
+    // ǷͨУųǽң
+    bool is_valid(Coordinate c) const;
+
+    // ȡķھӣ·㣩
+    std::vector<Coordinate> get_neighbors(Coordinate c) const;
+
+    // DFS·
+    void compute_dfs_path();
+
+    // BFS·㣨bfs_modeѡлλʵ֣
+    void compute_bfs_path();
+    void compute_bfs_queue();
+    void compute_bfs_bitset();
+
+    // ͨУʵ
+    bool validate_queue() const;
+    bool validate_bitset() const;
+
+    // ѿͨеؿ飨ǽңλͼ
+    BitGrid build_passability_bits() const;
+
+    // Dijkstra·㣨dijkstra_queueѡѻͰʵ֣·ͬ
+    void compute_dijkstra_path();
+    void compute_dijkstra_heap();
+    void compute_dijkstra_bucket();
+
+    // A*·㣨پxСؿΪ
+    void compute_astar_path();
+
+    // ˫յͬʱмmaze_search.cpp
+    void compute_bidirectional_bfs_path();
+    void compute_bidirectional_dijkstra_path();
+
+    // ǰtailݵ㣬õ·
+    std::vector<Coordinate> trace_path(const std::vector<uint8_t>& from_dir, Coordinate tail) const;
+
+    // 뷴ǰƴmeet·
+    std::vector<Coordinate> join_paths(const std::vector<uint8_t>& forward_dir,
+        const std::vector<uint8_t>& backward_dir, Coordinate meet) const;
+
+    // ؿ޸ĺе·볡ʧЧѸĶ֪滮maze_search.cpp
+    void replan_after_edit(Coordinate c);
+
+    // LPA*޸Dijkstra·չʱfalseɵ÷ͼ
+    bool compute_incremental_path();
+
+    // Ѱ·һĽۣͨΪ0
+    uint8_t planner_cell_cost(TileType type) const;
+
+    // Թļӳ䵽ڴ棬ħɵƻı
+    void load_maze(const std::string& filepath);
+    void load_binary_maze(const uint8_t* data, size_t size);
+    void load_text_maze(const char* data, size_t size);
+    void load_chunked_maze(const std::string& filepath);
+
+    // յҲǽϣֿʽУֻǵؿ飬ļͷ
+    bool endpoints_valid() const;
+
+    // ʧʱ㣬÷ݴжʧ
+    void reset_grid();
+    void generate_random_maze(int rows_, int cols_, uint32_t seed);
+
+    // ֿ鲢ɣmaze_generator.cppöе̣
+    // ڿͼȡͨǽԹ߳޹
+    void generate_tiled_maze(int rows_, int cols_, uint32_t seed, int threads);
+
+    // ɺյ㡢ݵ/ң֤㵽յͨ
+    void decorate_maze(std::mt19937& gen);
+
+    // 0-1 BFSҳٵ·ߣֻѸ·ϵҸΪذ壻ظĶ
+    int repair_lava_path();
+
+public:
+    // ļԹʧʱΪ0
+    MazeCore(const std::string& filepath);
+
+    // ļԹΪֿļ黺ռchunk_cache_bytesֽ
+    MazeCore(const std::string& filepath, size_t chunk_cache_bytes_);
+
+    // Թȡrandom_device
+    MazeCore(int rows, int cols);
+
+    // ָԹͬߴõͬԹ
+    MazeCore(int rows, int cols, uint32_t seed);
+
+    // threads̷ֿ߳鲢ɣͬߴõͬԹ߳޹أ
+    MazeCore(int rows, int cols, uint32_t seed, int threads);
+
+    // ָԹɹͨprogress㱨ȣ̨߳ʱʾؽȣ
+    MazeCore(int rows, int cols, uint32_t seed, ProgressCallback progress);
+
+    // ƶ̨߳ɵ񽻸̹߳Maze
+    MazeCore(MazeCore&&) = default;
+    MazeCore& operator=(MazeCore&&) = default;
+
+    virtual ~MazeCore() = default;
+
+    // У㵽յǷЧ·
+    bool validate_maze_path() const;
+
+    // ָ͵·ؽ
+    const std::vector<Coordinate>& compute_path(PathType type);
+
+    // μDFS/BFS/Dijkstra/A*·
+    void compute_all_paths();
+
+    // ȡѼ·NONEؿ·
+    const std::vector<Coordinate>& get_path(PathType type) const;
+
+    // ֱ·Ӵ̻صĽ֮has_pathΪtrue
+    void set_path(PathType type, std::vector<Coordinate> path);
+
+    // ָ͵·ǷѼ
+    bool has_path(PathType type) const;
+
+    // յһηDijkstraÿյĴһ򣨼maze_search.cpp
+    void compute_exit_field();
+    bool has_exit_field() const;
+
+    // fromյĴۣfromget_path_costһ£ɴδʱΪ-1
+    int get_cost_to_exit(Coordinate from) const;
+
+    // ؾ볡fromߵյ·ߣˣO(·߳)ɴʱΪ
+    std::vector<Coordinate> route_to_exit(Coordinate from) const;
+
+    // ޸һؿ飨յ񲻿ɸģҲɸĳSTART/ENDǷиĶ
+    // õ·볡֮ʧЧcompute_path1
+    bool can_set_tile(Coordinate c, TileType type) const;
+    bool set_tile_type(Coordinate c, TileType type);
+    uint64_t get_grid_generation() const;
+
+    // Ѱ·˺compute_path(DIJKSTRA)ϴνĻϾֲ޸
+    // ״ʱLPA*״̬൱һA*
+    void enable_incremental_planning();
+    bool is_incremental_planning() const;
+
+    // ȡָ㷨һչĽڵδʱΪ0
+    size_t get_expanded_nodes(PathType type) const;
+
+    // ؿ·ܴۣ㣬ҼƷһ£
+    int get_tile_cost(TileType type) const;
+    int get_min_tile_cost() const;
+    int get_max_tile_cost() const;
+    int get_path_cost(const std::vector<Coordinate>& path) const;
+
+    // ָDijkstraȶʵ֣ĬAUTO
+    void set_dijkstra_queue(DijkstraQueue queue);
+
+    // ָBFSͨУʵ֣ĬAUTO
+    void set_bfs_mode(BfsMode mode);
+
+    // Թıƴʽload_mazeأ
+    bool save_maze(const std::string& filepath, MazeFileFormat format = MazeFileFormat::TEXT) const;
+
+    // 
+    Coordinate get_start_coord() const;
+    Coordinate get_end_coord() const;
+    TileType get_tile_type(const Coordinate& coord) const;
+    int get_rows() const;
+    int get_cols() const;
+
+    // ֿ洢ʱ״̬ڴޣĬDEFAULT_SOLVER_STATE_BYTESʱcompute_path
+    // compute_exit_field⣬·Ϊաhas_pathΪfalse
+    void set_solver_state_limit(size_t bytes);
+
+    // ǷΪֿҳ洢Լ黺/ȱҳǷֿ洢ʱȫΪ0
+    bool is_chunked() const;
+    ChunkCacheStats get_chunk_cache_stats() const;
+};
+
+// ʽɣEller㷨maze_generator.cppɲֱдļ
+// ڴֻйأյݵ/дʱͬãֻͬ֤ͨ
+bool generate_eller_maze_file(int rows, int cols, uint32_t seed, const std::string& filepath, MazeFileFormat format);
+
+#endif // MAZE_CORE_H
@@ -0,0 +1,231 @@
+#include "maze_format.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+void MazeChecksum::update(const uint8_t* data, size_t size) {
+    // ȲϴʣµĲ8ֽ
+    if (pending_size > 0) {
+        size_t take = std::min(size, sizeof(pending) - pending_size);
+        std::memcpy(pending + pending_size, data, take);
+        pending_size += take;
+        data += take;
+        size -= take;
+        if (pending_size < sizeof(pending)) return;
+        uint64_t word;
+        std::memcpy(&word, pending, sizeof(word));
+        mix(word);
+        pending_size = 0;
+    }
+    for (; size >= 8; data += 8, size -= 8) {
+        uint64_t word;
+        std::memcpy(&word, data, 8);
+        mix(word);
+    }
+    std::memcpy(pending, data, size);
+    pending_size = size;
+}
+
+uint32_t MazeChecksum::finish() const {
+    MazeChecksum last = *this;
+    if (last.pending_size > 0) {
+        uint64_t word = 0;
+        std::memcpy(&word, last.pending, last.pending_size);
+        last.mix(word);
+    }
+    return static_cast<uint32_t>(last.hash ^ (last.hash >> 32));
+}
+
+MappedFile::MappedFile(const std::string& filepath) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return;
+    file_handle = file;
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size)) return;
+    mapped_size = static_cast<size_t>(file_size.QuadPart);
+    if (mapped_size == 0) {
+        opened = true;
+        return;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) return;
+    mapping_handle = mapping;
+    mapped = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    opened = (mapped != nullptr);
+#else
+    int fd = open(filepath.c_str(), O_RDONLY);
+    if (fd < 0) return;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return;
+    }
+    mapped_size = static_cast<size_t>(st.st_size);
+    if (mapped_size == 0) {
+        close(fd);
+        opened = true;
+        return;
+    }
+
+    void* addr = mmap(nullptr, mapped_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // ӳ佨󼴿ɹرļ
+    if (addr == MAP_FAILED) return;
+    madvise(addr, mapped_size, MADV_SEQUENTIAL);
+    mapped = static_cast<const uint8_t*>(addr);
+    opened = true;
+#endif
+}
+
+MappedFile::~MappedFile() {
+#ifdef _WIN32
+    if (mapped) UnmapViewOfFile(mapped);
+    if (mapping_handle) CloseHandle(mapping_handle);
+    if (file_handle) CloseHandle(file_handle);
+#else
+    if (mapped) munmap(const_cast<uint8_t*>(mapped), mapped_size);
+#endif
+}
+
+bool MappedFile::is_open() const {
+    return opened;
+}
+
+const uint8_t* MappedFile::data() const {
+    return mapped;
+}
+
+size_t MappedFile::size() const {
+    return mapped_size;
+}
+
+MazeFileWriter::MazeFileWriter(const std::string& filepath, int rows_, int cols_, MazeFileFormat format_)
+    : file(filepath, std::ios::binary), format(format_), rows(rows_), cols(cols_) {
+    if (!file.is_open()) {
+        std::cerr << "Failed to write maze file!" << std::endl;
+        return;
+    }
+
+    if (format == MazeFileFormat::TEXT) {
+        file << rows << " " << cols << "\n";
+    }
+    else {
+        // дռλļͷfinishʱ
+        MazeFileHeader header = {};
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        if (format == MazeFileFormat::PACKED) {
+            packed_buffer.resize((static_cast<size_t>(cols) + 1) / 2);
+        }
+        else if (format == MazeFileFormat::CHUNKED) {
+            chunk_rows.resize(static_cast<size_t>(cols) << MAZE_CHUNK_SHIFT);
+            packed_buffer.resize(static_cast<size_t>(1) << (2 * MAZE_CHUNK_SHIFT));
+        }
+    }
+}
+
+bool MazeFileWriter::is_open() const {
+    return file.is_open();
+}
+
+void MazeFileWriter::write_row(const uint8_t* row) {
+    if (format == MazeFileFormat::TEXT) {
+        line_buffer.clear();
+        for (int c = 0; c < cols; ++c) {
+            if (c > 0) line_buffer += ' ';
+            line_buffer += std::to_string(static_cast<int8_t>(row[c]));
+        }
+        line_buffer += '\n';
+        file.write(line_buffer.data(), line_buffer.size());
+    }
+    else if (format == MazeFileFormat::BINARY) {
+        checksum.update(row, cols);
+        file.write(reinterpret_cast<const char*>(row), cols);
+    }
+    else if (format == MazeFileFormat::CHUNKED) {
+        const int chunk_size = 1 << MAZE_CHUNK_SHIFT;
+        int buffered = rows_written % chunk_size;
+        std::memcpy(chunk_rows.data() + static_cast<size_t>(buffered) * cols, row, cols);
+        if (buffered == chunk_size - 1) {
+            ++rows_written;
+            flush_chunk_rows();
+            return;
+        }
+    }
+    else {
+        // ÿеֽڶ룬ʱֽڲ0
+        std::fill(packed_buffer.begin(), packed_buffer.end(), 0);
+        for (int c = 0; c < cols; ++c) {
+            packed_buffer[c / 2] |= encode_tile_nibble(row[c]) << ((c % 2) * 4);
+        }
+        checksum.update(packed_buffer.data(), packed_buffer.size());
+        file.write(reinterpret_cast<const char*>(packed_buffer.data()), packed_buffer.size());
+    }
+    ++rows_written;
+}
+
+void MazeFileWriter::flush_chunk_rows() {
+    // µһУһпܲд򣬲Ĳֲǽ
+    const int chunk_size = 1 << MAZE_CHUNK_SHIFT;
+    int buffered = (rows_written - 1) % chunk_size + 1;
+    for (int x0 = 0; x0 < cols; x0 += chunk_size) {
+        int span = std::min(chunk_size, cols - x0);
+        std::fill(packed_buffer.begin(), packed_buffer.end(), static_cast<uint8_t>(1)); // 1 = ǽ
+        for (int r = 0; r < buffered; ++r) {
+            std::memcpy(packed_buffer.data() + (static_cast<size_t>(r) << MAZE_CHUNK_SHIFT),
+                chunk_rows.data() + static_cast<size_t>(r) * cols + x0, span);
+        }
+        checksum.update(packed_buffer.data(), packed_buffer.size());
+        file.write(reinterpret_cast<const char*>(packed_buffer.data()), packed_buffer.size());
+    }
+}
+
+bool MazeFileWriter::finish(int start_x, int start_y, int end_x, int end_y) {
+    if (!file.is_open()) return false;
+    if (rows_written != rows) {
+        std::cerr << "Maze file incomplete: " << rows_written << "/" << rows << " rows" << std::endl;
+        return false;
+    }
+
+    if (format == MazeFileFormat::CHUNKED && rows % (1 << MAZE_CHUNK_SHIFT) != 0) {
+        flush_chunk_rows(); // һĿ
+    }
+
+    if (format != MazeFileFormat::TEXT) {
+        MazeFileHeader header = {};
+        std::memcpy(header.magic, MAZE_FILE_MAGIC, sizeof(header.magic));
+        header.version = MAZE_FILE_VERSION;
+        if (format == MazeFileFormat::CHUNKED) {
+            header.encoding = MAZE_ENCODING_CHUNKED;
+            header.chunk_shift = MAZE_CHUNK_SHIFT;
+        }
+        else {
+            header.encoding = (format == MazeFileFormat::BINARY) ? MAZE_ENCODING_BYTE : MAZE_ENCODING_NIBBLE;
+        }
+        header.rows = rows;
+        header.cols = cols;
+        header.start_x = start_x;
+        header.start_y = start_y;
+        header.end_x = end_x;
+        header.end_y = end_y;
+        header.checksum = checksum.finish();
+        file.seekp(0);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+    file.flush();
+    return file.good();
+}
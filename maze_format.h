@@ -0,0 +1,116 @@
+#ifndef MAZE_FORMAT_H
+#define MAZE_FORMAT_H
+
+// Թļʽload_mazeʹõıʽ"rows cols"
+// ԼƸʽļͷ + ÿ1ֽڻÿ4λƸʽӳֱӿ
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Թļʽ
+enum class MazeFileFormat {
+    TEXT,   // ı"rows cols"дؿֵ
+    PACKED, // ƣMazeFileHeaderÿֽڴ񣨵4λǰ
+    BINARY, // ƣMazeFileHeaderÿ1ֽڣڴе񲼾ͬʱ
+    CHUNKED // ƣMazeFileHeader󰴿ţÿ߳2^chunk_shiftÿ1ֽڣʱҳ
+};
+
+// ļͷСˣ36ֽڣ
+struct MazeFileHeader {
+    char magic[4];      // "MZPK"
+    uint16_t version;   // ʽ汾
+    uint8_t encoding;   // ؿ룺1 = ÿ4λ2 = ÿ1ֽڣ3 = ֿ
+    uint8_t chunk_shift; // ֿĿ߳log2Ϊ0
+    int32_t rows;
+    int32_t cols;
+    int32_t start_x;
+    int32_t start_y;
+    int32_t end_x;
+    int32_t end_y;
+    uint32_t checksum;  // ؿݵУͣMazeChecksum
+};
+static_assert(sizeof(MazeFileHeader) == 36, "MazeFileHeader must be 36 bytes");
+
+const char MAZE_FILE_MAGIC[4] = { 'M', 'Z', 'P', 'K' };
+const uint16_t MAZE_FILE_VERSION = 2; // 汾2У͸Ϊ8ּֽ
+const uint8_t MAZE_ENCODING_NIBBLE = 1;
+const uint8_t MAZE_ENCODING_BYTE = 2;
+const uint8_t MAZE_ENCODING_CHUNKED = 3;
+const int MAZE_CHUNK_SHIFT = 8; // дֿļʱĿ߳256x256ÿ64KB
+
+// ؿֵ4λ뻥תEND(-2)..LAVA(3)ӳ䵽0..5
+inline uint8_t encode_tile_nibble(uint8_t tile) { return static_cast<uint8_t>(static_cast<int8_t>(tile) + 2); }
+inline uint8_t decode_tile_nibble(uint8_t nibble) { return static_cast<uint8_t>(static_cast<int8_t>(nibble) - 2); }
+
+// ؿУͣ8ֽСFNV-1aʽٳˣ64λֽڿԼ8
+// ɰзֶ£һԼͬ8ֽڵβ0
+class MazeChecksum {
+private:
+    uint64_t hash = 14695981039346656037ull;
+    uint8_t pending[8] = {};
+    size_t pending_size = 0;
+
+    void mix(uint64_t word) {
+        hash ^= word;
+        hash *= 1099511628211ull;
+    }
+
+public:
+    void update(const uint8_t* data, size_t size);
+    uint32_t finish() const;
+};
+
+// MappedFileֻʽļӳ䵽ڴ棨POSIX mmap / Windowsļӳ䣩
+// ʱӳ䣻ļҲΪ򿪳ɹʱdataΪnullptr
+class MappedFile {
+private:
+    const uint8_t* mapped = nullptr;
+    size_t mapped_size = 0;
+    bool opened = false;
+#ifdef _WIN32
+    void* file_handle = nullptr;
+    void* mapping_handle = nullptr;
+#endif
+
+public:
+    explicit MappedFile(const std::string& filepath);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool is_open() const;
+    const uint8_t* data() const;
+    size_t size() const;
+};
+
+// MazeFileWriterдԹļڴֻռһУʽ뱣
+class MazeFileWriter {
+private:
+    std::ofstream file;
+    MazeFileFormat format;
+    int rows;
+    int cols;
+    int rows_written = 0;
+    MazeChecksum checksum;
+    std::string line_buffer;
+    std::vector<uint8_t> packed_buffer;
+    std::vector<uint8_t> chunk_rows; // ֿʽܹһٰд
+
+    void flush_chunk_rows();
+
+public:
+    MazeFileWriter(const std::string& filepath, int rows_, int cols_, MazeFileFormat format_);
+
+    bool is_open() const;
+
+    // дһеؿ飨colsTileTypeֽڣ
+    void write_row(const uint8_t* row);
+
+    // дкãƸʽյУ
+    bool finish(int start_x, int start_y, int end_x, int end_y);
+};
+
+#endif // MAZE_FORMAT_H
@@ -6,24 +6,39 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <stack>
 #include <queue>
 #include <tuple>
 #include <climits>
 #include <chrono>
 #include <memory>
+#include <future>
+#include <mutex>
+#include <functional>
 #include "raymath.h"
+#include "maze_core.h"
+#include "player_sim.h"
+#include "replay.h"
+#include "maze_cache.h"
 
 // Թس
 const int TILE_WIDTH = 48;
 const int TILE_HEIGHT = 48;
 const int MAX_SCREEN_WIDTH = 1920;  // Ļ
 const int MAX_SCREEN_HEIGHT = 1080; // Ļ߶
+const int TILE_TYPE_COUNT = 6;      // ؿEND..LAVAͼŲ
+
+// ̬ؿ㣺ÿLAYER_CHUNK_TILES x LAYER_CHUNK_TILESԤȻһȾ
+// ໺MAX_LAYER_CHUNKS飻ɼޣúСʱΪֱӰͼ
+const int LAYER_CHUNK_TILES = 16;
+const int MAX_LAYER_CHUNKS = 48;
 
 // Ϸ״̬ö
 enum class GameState {
     MENU,
     RANDOM_MAZE_SELECT,
+    LOADING,        // ̨߳Թѭճƽ
     GAME_PLAYING,
     GAME_OVER
 };
@@ -35,91 +50,99 @@ enum class GameOverOption {
     EXIT       // ˳Ϸ
 };
 
-// ؿö
-enum class TileType {
-    END = -2,
-    START = -1,
-    FLOOR = 0,
-    WALL = 1,
-    GRASS = 2,
-    LAVA = 3
+// ɼؿ鷶Χ뿪[x0, x1) x [y0, y1)
+struct TileRange {
+    int x0, y0, x1, y1;
+    bool contains(Coordinate c) const { return c.x >= x0 && c.x < x1 && c.y >= y0 && c.y < y1; }
 };
 
-// ·ö٣ʾ·
-enum class PathType {
-    NONE,   // ʾ·
-    DFS,    // ·
-    BFS,    // ·
-    DIJKSTRA // Dijkstra·
+// һ֡Ļͳƣʾ
+struct DrawStats {
+    int draw_calls = 0;     // ύ/λ
+    int batches = 0;        // ÿлһraylibҪύһ
+    int chunks_cached = 0;  // ѻľ̬
+    int chunks_rebuilt = 0; // ֡ػľ̬
 };
 
-// ṹ
-struct Coordinate {
-    int x, y;
-    bool operator==(const Coordinate& other) const;
-};
+// MazeࣺMazeCoreϸ
+class Maze : public MazeCore {
+private:
+    // ֵؿϳһͼtile_srcؿͣENDΪ0ͼڵԴ
+    Texture2D atlas = {};
+    Rectangle tile_src[TILE_TYPE_COUNT] = {};
+
+    // ̬ؿ㻺棬Ϊ
+    struct LayerChunk {
+        RenderTexture2D target;
+        bool dirty;
+    };
+    std::unordered_map<size_t, LayerChunk> layer_chunks;
+
+    int layer_chunks_x() const { return (cols + LAYER_CHUNK_TILES - 1) / LAYER_CHUNK_TILES; }
+    size_t layer_chunk_id(int cx, int cy) const { return static_cast<size_t>(cy) * layer_chunks_x() + cx; }
+    std::vector<PathType> shown_paths; // ǰʾ·ͬʱӶԱȣ
+
+    // ·ǵĶ㻺壺·仯ʱһβϴԴ棬̬Ͱ
+    // ʱÿɼͰһDrawMeshÿ֡ύ㣻ʱͷԴ
+    struct PathOverlay {
+        std::unordered_map<size_t, Mesh> buckets; // ÿ2
+        PathOverlay() = default;
+        PathOverlay(const PathOverlay&) = delete;
+        PathOverlay& operator=(const PathOverlay&) = delete;
+        ~PathOverlay() { clear(); }
+        void clear();
+    };
+    std::map<PathType, PathOverlay> path_overlays;
+    Material overlay_material = {}; // Ĭɫɫ·ɫɫ
 
-// Ϊӹϣunordered_map
-template<> struct std::hash<Coordinate> {
-    size_t operator()(const Coordinate& c) const;
-};
+    // Ӵ˴·ʾ볡̨úһʱس·ؽ
+    bool show_route_hint = false;
+    std::future<void> exit_field_task;
+    Coordinate hint_from = { -1, -1 }; // ǰʾӦʼδʱΪЧ
+    PathOverlay hint_overlay;
+    int edit_count = 0; // Ӧõĵؿ޸Ĵ
 
-// ״̬ö
-enum class PlayerState {
-    STANDING,
-    DOWN,
-    LEFT,
-    RIGHT,
-    UP
-};
+    // ·ں̨㣺״ѡĳ·ʱ񣬽MazeCore·Ա
+    std::map<PathType, std::future<void>> path_tasks;
+    std::mutex solver_mutex; // ̨⴮ִУexpanded_nodes
 
-// س
-const float PLAYER_SPEED = 200.0f;
-const float PLAYER_FRAME_TIME = 0.1f;
+    // ؿ޸ĺϵĺ̨Ŷеİ⣬ܶfutureȴ
+    std::vector<std::future<void>> retired_tasks;
 
-// MazeࣺԹ·Թɣ
-class Maze {
-private:
-    struct Tile {
-        TileType type;
-        Vector2 position;
-    };
+    // ߳æʱݴ޸ģ֮ÿ֡õʱӦã̲߳ȴ̨
+    std::vector<std::pair<Coordinate, TileType>> pending_edits;
+    void apply_pending_edits();
+    DrawStats draw_stats;
 
-    std::map<TileType, Texture2D> textures;
-    std::vector<std::vector<Tile>> tiles;
-    Coordinate start_coord;
-    Coordinate end_coord;
-    int rows;
-    int cols;
+    void load_textures();
 
-    // ·洢
-    std::vector<Coordinate> dfs_path;
-    std::vector<Coordinate> bfs_path;
-    std::vector<Coordinate> dijkstra_path;
-    PathType current_path_type = PathType::NONE; // ǰʾ·
+    // ·δʱں̨ʼ
+    void request_path(PathType type);
 
-    // ǷͨУųǽң
-    bool is_valid(Coordinate c) const;
+    // 볡δʱں̨ʼ
+    void request_exit_field();
 
-    // ȡķھӣ·㣩
-    std::vector<Coordinate> get_neighbors(Coordinate c) const;
+    // ȡ·ǵĶ㻺棬״ȡʱ·꣩
+    const PathOverlay& get_path_overlay(PathType type);
 
-    // У㵽յǷЧ·
-    bool validate_maze_path();
+    // һ갴̬ͰдɱǶ
+    void build_overlay(const std::vector<Coordinate>& path, PathOverlay& overlay) const;
 
-    // DFS·
-    void compute_dfs_path();
+    // ƿɼͰطDrawMesh
+    int draw_overlay(const PathOverlay& overlay, Color color, float offset, const TileRange& visible_chunks);
 
-    // BFS·
-    void compute_bfs_path();
+    // ؿͶӦԴΣEND..LAVAڵֵļֽڣǽ
+    const Rectangle& tile_source(TileType type) const {
+        unsigned index = static_cast<unsigned>(static_cast<int>(type) - static_cast<int>(TileType::END));
+        if (index >= static_cast<unsigned>(TILE_TYPE_COUNT)) index = static_cast<int>(TileType::WALL) - static_cast<int>(TileType::END);
+        return tile_src[index];
+    }
 
-    // Dijkstra·
-    int get_tile_cost(TileType type) const;
-    void compute_dijkstra_path();
+    // ѷΧڵĵؿ鰴ͼ񻭵ǰĿ꣬originΪΧϽǶӦλ
+    void draw_tiles(const TileRange& range, Vector2 origin);
 
-    void load_textures();
-    void load_maze(const std::string& filepath);
-    void generate_random_maze(int rows_, int cols_);
+    // ȡɼȾδʧЧʱػʱ̭ɼĿ飩
+    const LayerChunk& get_layer_chunk(int cx, int cy, const TileRange& visible_chunks);
 
 public:
     // ļԹ
@@ -128,68 +151,98 @@ public:
     // Թ
     Maze(int rows, int cols);
 
+    // ӹɺǫ̃߳ɵMazeCoreֻڵǰ̼߳
+    Maze(MazeCore&& core);
+
     ~Maze();
 
-    // õǰʾ·
+    // õǰʾ·ͣ·δʱں̨ʼ㣩
     void set_current_path(PathType type);
 
-    // ·
-    void draw_path_marker(Coordinate c, Color color) const;
+    // ӻȡһ·ڶ㷨Ա
+    void toggle_path(PathType type);
+
+    // ָ·ǷѼɣNONEΪɣ
+    bool is_path_ready(PathType type) const;
 
-    // ĻƷ
+    // ءӴ˴·ʾ״δʱں̨㵽յľ볡
+    void toggle_route_hint();
+    bool is_exit_field_ready() const;
+
+    // ÿ֡ڸֻڻʱؾ볡ؽʾ·ߣ
+    void update_route_hint(Coordinate from);
+
+    // Ļɼĵؿ鷶ΧĽǷͶӰȡΧУõڣ
+    TileRange get_visible_range(const Camera2D& camera) const;
+
+    // ĻƷֻƿɼΧڵĵؿ·ǣ
     void draw(const Camera2D& camera);
 
-    // 
-    Coordinate get_start_coord() const;
-    Coordinate get_end_coord() const;
-    TileType get_tile_type(const Coordinate& coord) const;
+    // ؿ鱻޸ĺãʹǸøľ̬´λʱػ
+    void invalidate_tile(Coordinate c);
+
+    // ޸һؿ飨Ȱݴ޸ĵУ飬ЧʱfalseѰ·˺Dijkstra·
+    // ں̨LPA*ֲ޸·볡ϣʾں̨㡣
+    // ߳æʱ޸ݴ棬ԺӦãͬһݴ޸ֻһ
+    bool set_tile_type(Coordinate c, TileType type);
+
+    // ݴ޸ĺĵؿͣ༭ʱݴ˾һͣ
+    TileType get_edited_tile_type(Coordinate c) const;
+
+    // Ӧõ޸Ĵ
+    int get_edit_count() const;
+
+    // ڵĸ񣨿⣩
+    Coordinate get_tile_coord(Vector2 world) const;
+
+    // һ֡ĻƵ뾲̬㻺ȷ֡ʱԹߴ޹
+    const DrawStats& get_draw_stats() const;
+
     Vector2 get_tile_position(const Coordinate& coord) const;
-    int get_rows() const;
-    int get_cols() const;
 };
 
-// Player
+// PlayerࣺPlayerSimϸ롢ֵ
 class Player {
 private:
     Texture2D texture;
-    Vector2 position;
-    Coordinate curr_coor;
-    Vector2 target_position;
     Rectangle curr_frame_rectangle;
-    int curr_frame;
-    float timer;
-    float speed;
-    PlayerState state;
-    const Maze& maze;
-    bool is_win;
-    int walk_score;
-    bool is_dead;
+    PlayerSim sim;
+    InputRecorder recorder; // ÿ붼¼ԾֽɴΪ¼
+    float accumulator = 0;  // δ֡ʱ䣬SIM_DTƽһ
 
+    // Ӽ̶ȡķ
+    static MoveInput poll_input();
     void determine_frame_rectangle();
-    void turn(PlayerState new_state);
-    void walk_update();
-    void control_update();
 
 public:
     Player(const Maze& maze_ref);
     ~Player();
 
+    // ֡ʱƽɹ̶ģⲽ
     void update();
     void draw(const Camera2D& camera);
 
     int get_score() const;
+    Coordinate get_coord() const;
     bool is_win_state() const;
     bool is_dead_state() const;
 
+    // Ϸʱ룩ģⲽ㣬طʱɾȷ
+    double get_game_time() const;
+
+    // ֵ¼ڱ¼
+    const std::vector<InputEvent>& get_inputs() const;
+    ReplayResult get_result() const;
+
     void reset();
 };
 
-// ʱ
+// ʱࣨʱӣ뾫ȣ
 class Timer {
 private:
-    std::chrono::high_resolution_clock::time_point start_time;
+    std::chrono::steady_clock::time_point start_time;
     bool is_running;
-    float elapsed_time;
+    int64_t elapsed_ns;
 
 public:
     Timer();
@@ -197,7 +250,109 @@ public:
     void start();
     void stop();
     void reset();
-    float get_elapsed_time() const;
+    int64_t get_elapsed_ns() const;
+    float get_elapsed_time() const; // 
+};
+
+// ֡ڷֶΣFrameProfiler˼¼κʱ
+enum class ProfilePhase {
+    UPDATE,        // ״̬£Ҹ£
+    PLAYER_UPDATE, // Player::update
+    MAZE_DRAW,     // Maze::draw
+    PLAYER_DRAW,   // Player::draw
+    HUD,           // 
+    PROFILER,      // ֡ʱ屾HUDֿƣڿĿ
+    END_DRAWING,   // EndDrawingύƲȴֱͬ
+    COUNT
+};
+
+const int PROFILE_FRAMES = 240; // λ屣֡60FPSԼ4룩
+
+// FrameProfiler֡¼ֶεֹʱ䣬̶СĻλ壬ÿ֡ڴ棻
+// ɻ֡ʱֶϸ赼CSVChrome trace JSONchrome://tracingɴ򿪣
+class FrameProfiler {
+private:
+    struct FrameRecord {
+        int64_t start_ns;
+        int64_t frame_ns;
+        int64_t phase_start_ns[static_cast<int>(ProfilePhase::COUNT)];
+        int64_t phase_ns[static_cast<int>(ProfilePhase::COUNT)];
+    };
+    FrameRecord frames[PROFILE_FRAMES] = {};
+    int head = 0;  // ǰڼ¼֡
+    int count = 0; // Ѽ¼ɵ֡PROFILE_FRAMES
+    Timer clock;   // ԹʱΪʱĻ׼
+
+    const FrameRecord& frame_at(int age) const; // ageΪ0ʾɵһ֡
+
+public:
+    FrameProfiler();
+
+    void begin_frame();
+    void end_frame();
+    void begin_phase(ProfilePhase phase);
+    void end_phase(ProfilePhase phase);
+
+    // ֶΣʱʼʱ
+    class Zone {
+    private:
+        FrameProfiler& profiler;
+        ProfilePhase phase;
+    public:
+        Zone(FrameProfiler& profiler_, ProfilePhase phase_) : profiler(profiler_), phase(phase_) { profiler.begin_phase(phase); }
+        ~Zone() { profiler.end_phase(phase); }
+    };
+
+    // Ļ(x, y)֡ʱֶεƽ/ʱ
+    void draw_overlay(int x, int y) const;
+
+    bool export_csv(const std::string& filepath) const;
+    bool export_chrome_trace(const std::string& filepath) const;
+};
+
+// Դļͳ
+struct AssetStats {
+    int loads = 0;        // ʵʽ벢ϴ
+    int hits = 0;         // лĴ
+    double load_ms = 0.0; // ۼƼغʱ
+};
+
+// AssetCacheڹ棬߼"floor.png"ü
+// ļ·ԴĿ¼ùڻٴνϷʱ¼أ
+// CloseWindow֮ǰunload_all
+class AssetCache {
+private:
+    struct Entry {
+        Texture2D texture;
+        int refs;
+    };
+    std::string root = "./assets";
+    std::unordered_map<std::string, Entry> textures;
+    AssetStats stats;
+
+    AssetCache() = default;
+
+public:
+    static AssetCache& instance();
+
+    // ԴĿ¼--assetsȣλMAZE_ASSET_ROOTĬ./assets
+    void set_root(const std::string& dir);
+    const std::string& get_root() const;
+    std::string resolve(const std::string& name) const;
+
+    // ȡãδʱԴĿ¼
+    Texture2D acquire_texture(const std::string& name);
+
+    // ȡãδʱbuildͼϴͼȺϳ
+    Texture2D acquire_texture(const std::string& name, const std::function<Image()>& build);
+
+    void release_texture(const std::string& name);
+
+    // жΪ0 / жȫ
+    void unload_unused();
+    void unload_all();
+
+    const AssetStats& get_stats() const;
 };
 
 // ʼԹߴ磩
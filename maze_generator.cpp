@@ -0,0 +1,275 @@
+#include "maze_core.h"
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <stack>
+#include <thread>
+#include <utility>
+
+// ֿСԪÿӦԼ513x513ؿ
+static const int GENERATOR_TILE_CELLS = 256;
+
+// 鼯ͼKruskal
+static int find_root(std::vector<int>& parent, int x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+void MazeCore::generate_tiled_maze(int rows_, int cols_, uint32_t seed, int threads) {
+    // 1. ǿԹߴΪλΪǽ
+    rows = (rows_ % 2 == 0) ? rows_ + 1 : rows_;
+    cols = (cols_ % 2 == 0) ? cols_ + 1 : cols_;
+    tiles.assign(static_cast<size_t>(rows) * cols, static_cast<uint8_t>(TileType::WALL));
+
+    // 2. Ԫ(i, j)Ӧؿ(2j+1, 2i+1)GENERATOR_TILE_CELLSΪ
+    const int cell_rows = (rows - 1) / 2;
+    const int cell_cols = (cols - 1) / 2;
+    const int tile_rows = (cell_rows + GENERATOR_TILE_CELLS - 1) / GENERATOR_TILE_CELLS;
+    const int tile_cols = (cell_cols + GENERATOR_TILE_CELLS - 1) / GENERATOR_TILE_CELLS;
+    const int tile_count = tile_rows * tile_cols;
+
+    // 3. DFSֻʱ鵥Ԫֻͨڵǽдĵؿ黥ص
+    auto carve_tile = [&](int tile_id) {
+        int i0 = (tile_id / tile_cols) * GENERATOR_TILE_CELLS;
+        int j0 = (tile_id % tile_cols) * GENERATOR_TILE_CELLS;
+        int i1 = std::min(i0 + GENERATOR_TILE_CELLS, cell_rows);
+        int j1 = std::min(j0 + GENERATOR_TILE_CELLS, cell_cols);
+        int h = i1 - i0;
+        int w = j1 - j0;
+
+        // ÿֻž
+        std::seed_seq seq{ seed, static_cast<uint32_t>(tile_id) };
+        std::mt19937 gen(seq);
+        std::uniform_int_distribution<> dir_dist(0, 3);
+
+        std::vector<uint8_t> visited(static_cast<size_t>(h) * w, 0);
+        std::stack<std::pair<int, int>, std::vector<std::pair<int, int>>> stack;
+        stack.push({ 0, 0 });
+        visited[0] = 1;
+        set_tile(2 * j0 + 1, 2 * i0 + 1, TileType::FLOOR);
+
+        while (!stack.empty()) {
+            auto [i, j] = stack.top();
+            std::pair<int, int> neighbors[4];
+            int count = 0;
+            if (i > 0 && !visited[(i - 1) * w + j]) neighbors[count++] = { i - 1, j };
+            if (i < h - 1 && !visited[(i + 1) * w + j]) neighbors[count++] = { i + 1, j };
+            if (j > 0 && !visited[i * w + j - 1]) neighbors[count++] = { i, j - 1 };
+            if (j < w - 1 && !visited[i * w + j + 1]) neighbors[count++] = { i, j + 1 };
+
+            if (count == 0) {
+                stack.pop();
+                continue;
+            }
+            auto [ni, nj] = neighbors[dir_dist(gen) % count];
+            // ͨǽĿ굥Ԫ񣨵ؿΪԪ֮+1
+            set_tile(j0 + j + j0 + nj + 1, i0 + i + i0 + ni + 1, TileType::FLOOR);
+            set_tile(2 * (j0 + nj) + 1, 2 * (i0 + ni) + 1, TileType::FLOOR);
+            visited[ni * w + nj] = 1;
+            stack.push({ ni, nj });
+        }
+    };
+
+    // 4. ̰߳ԭӼȡ飻߳޹أ˽߳޹
+    int worker_count = std::max(1, std::min(threads, tile_count));
+    std::atomic<int> next_tile{ 0 };
+    auto worker = [&]() {
+        for (int t = next_tile++; t < tile_count; t = next_tile++) {
+            carve_tile(t);
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int k = 1; k < worker_count; ++k) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& th : pool) {
+        th.join();
+    }
+
+    // 5. ͼÿ齻紦ͨһǽΪһ
+    std::mt19937 gen(seed);
+    struct TileEdge {
+        int a, b;
+        bool horizontal; // trueڣfalse
+    };
+    std::vector<TileEdge> edges;
+    for (int t = 0; t < tile_count; ++t) {
+        int tr = t / tile_cols;
+        int tc = t % tile_cols;
+        if (tc + 1 < tile_cols) edges.push_back({ t, t + 1, true });
+        if (tr + 1 < tile_rows) edges.push_back({ t, t + tile_cols, false });
+    }
+    std::shuffle(edges.begin(), edges.end(), gen);
+
+    std::vector<int> parent(tile_count);
+    std::iota(parent.begin(), parent.end(), 0);
+    for (const TileEdge& e : edges) {
+        int ra = find_root(parent, e.a);
+        int rb = find_root(parent, e.b);
+        if (ra == rb) continue;
+        parent[ra] = rb;
+
+        int i0 = (e.a / tile_cols) * GENERATOR_TILE_CELLS;
+        int j0 = (e.a % tile_cols) * GENERATOR_TILE_CELLS;
+        if (e.horizontal) {
+            // aһеԪbһ֮ǽ
+            int i1 = std::min(i0 + GENERATOR_TILE_CELLS, cell_rows);
+            int i = std::uniform_int_distribution<>(i0, i1 - 1)(gen);
+            int j = j0 + GENERATOR_TILE_CELLS - 1;
+            set_tile(2 * j + 2, 2 * i + 1, TileType::FLOOR);
+        }
+        else {
+            // aһеԪbһ֮ǽ
+            int j1 = std::min(j0 + GENERATOR_TILE_CELLS, cell_cols);
+            int j = std::uniform_int_distribution<>(j0, j1 - 1)(gen);
+            int i = i0 + GENERATOR_TILE_CELLS - 1;
+            set_tile(2 * j + 1, 2 * i + 2, TileType::FLOOR);
+        }
+    }
+
+    // 6. յ㡢ݵ/ͨ޸
+    decorate_maze(gen);
+}
+
+bool generate_eller_maze_file(int rows_, int cols_, uint32_t seed, const std::string& filepath, MazeFileFormat format) {
+    // 1. ǿԹߴΪ
+    const int rows = (rows_ % 2 == 0) ? rows_ + 1 : rows_;
+    const int cols = (cols_ % 2 == 0) ? cols_ + 1 : cols_;
+    const int cell_rows = (rows - 1) / 2;
+    const int cell_cols = (cols - 1) / 2;
+    if (cell_rows <= 0 || cell_cols <= 0) return false;
+
+    MazeFileWriter writer(filepath, rows, cols, format);
+    if (!writer.is_open()) return false;
+
+    std::mt19937 gen(seed);
+    std::bernoulli_distribution coin(0.5);
+    std::uniform_int_distribution<> type_dist(0, 19); // ؿ͸
+
+    // 2. ǰԪеļ״̬ǩÿнʱѹ[0, cell_cols)
+    std::vector<int> label(cell_cols);
+    std::vector<int> parent(cell_cols);
+    std::iota(label.begin(), label.end(), 0);
+    auto find = [&](int x) { return find_root(parent, x); };
+
+    std::vector<uint8_t> right_open(cell_cols, 0); // Ҳ൥Ԫ֮Ѵͨ
+    std::vector<uint8_t> down_open(cell_cols, 0);  // ·Ԫ֮Ѵͨ
+    std::vector<uint8_t> up_open(cell_cols, 0);    // ϷԪ֮Ѵͨһеdown_open
+    std::vector<int> down_count(cell_cols);        // ´ͨĸ
+    std::vector<int> member_count(cell_cols);      // ڱеĸ
+    std::vector<int> fallback(cell_cols);          // ѡеһˮس
+    std::vector<int> remap(cell_cols);
+
+    // ݵ/ңԭһյĵԪѡmin(/3, 30)
+    // ѡKnuth㷨S豣ȫѡ
+    const long long candidates = static_cast<long long>(cell_rows) * cell_cols - 2;
+    long long remaining = std::max(0LL, candidates);
+    long long to_pick = std::min(remaining / 3, 30LL);
+
+    std::vector<uint8_t> row_buffer(cols);
+    auto fill_row = [&](TileType type) { std::fill(row_buffer.begin(), row_buffer.end(), static_cast<uint8_t>(type)); };
+
+    // 3. ߽
+    fill_row(TileType::WALL);
+    writer.write_row(row_buffer.data());
+
+    for (int i = 0; i < cell_rows; ++i) {
+        const bool last_row = (i == cell_rows - 1);
+        std::iota(parent.begin(), parent.end(), 0);
+
+        // 3.1 ҲͬһϵĵԪϲһбȫϲ
+        for (int j = 0; j + 1 < cell_cols; ++j) {
+            right_open[j] = 0;
+            int a = find(label[j]);
+            int b = find(label[j + 1]);
+            if (a != b && (last_row || coin(gen))) {
+                parent[a] = b;
+                right_open[j] = 1;
+            }
+        }
+        right_open[cell_cols - 1] = 0;
+
+        // 3.2 ÿ´ͨһ
+        std::fill(down_count.begin(), down_count.end(), 0);
+        std::fill(member_count.begin(), member_count.end(), 0);
+        for (int j = 0; j < cell_cols; ++j) {
+            int root = find(label[j]);
+            down_open[j] = (!last_row && coin(gen)) ? 1 : 0;
+            down_count[root] += down_open[j];
+            ++member_count[root];
+            if (std::uniform_int_distribution<>(1, member_count[root])(gen) == 1) {
+                fallback[root] = j;
+            }
+        }
+        if (!last_row) {
+            for (int j = 0; j < cell_cols; ++j) {
+                int root = find(label[j]);
+                if (down_count[root] == 0) {
+                    down_open[fallback[root]] = 1;
+                    down_count[root] = 1;
+                }
+            }
+        }
+
+        // 3.3 дԪУյ㡢ݵ/ңֻͬΨһͨ·
+        fill_row(TileType::WALL);
+        for (int j = 0; j < cell_cols; ++j) {
+            int x = 2 * j + 1;
+            TileType type = TileType::FLOOR;
+            if (i == 0 && j == 0) {
+                type = TileType::START;
+            }
+            else if (last_row && j == cell_cols - 1) {
+                type = TileType::END;
+            }
+            else if (to_pick > 0 && std::uniform_int_distribution<long long>(0, remaining - 1)(gen) < to_pick) {
+                --to_pick;
+                int degree = up_open[j] + down_open[j] + right_open[j] + (j > 0 ? right_open[j - 1] : 0);
+                int rand_type = type_dist(gen);
+                if (rand_type < 15) { // 75% ݵ
+                    type = TileType::GRASS;
+                }
+                else if (rand_type >= 18 && degree == 1) { // 10% 
+                    type = TileType::LAVA;
+                }
+            }
+            if (!(i == 0 && j == 0) && !(last_row && j == cell_cols - 1)) {
+                --remaining;
+            }
+            row_buffer[x] = static_cast<uint8_t>(type);
+            if (right_open[j]) row_buffer[x + 1] = static_cast<uint8_t>(TileType::FLOOR);
+        }
+        writer.write_row(row_buffer.data());
+
+        // 3.4 дԪ·ǽУһмײ߽磩
+        fill_row(TileType::WALL);
+        for (int j = 0; j < cell_cols; ++j) {
+            if (down_open[j]) row_buffer[2 * j + 1] = static_cast<uint8_t>(TileType::FLOOR);
+        }
+        writer.write_row(row_buffer.data());
+
+        // 3.5 һУ´ͨĸϣ¼ϣǩѹ[0, cell_cols)
+        std::fill(remap.begin(), remap.end(), -1);
+        int next_label = 0;
+        for (int j = 0; j < cell_cols; ++j) {
+            if (down_open[j]) {
+                int root = find(label[j]);
+                if (remap[root] < 0) remap[root] = next_label++;
+                label[j] = remap[root];
+            }
+            else {
+                label[j] = -1;
+            }
+        }
+        for (int j = 0; j < cell_cols; ++j) {
+            if (label[j] < 0) label[j] = next_label++;
+        }
+        up_open.swap(down_open);
+    }
+
+    return writer.finish(1, 1, cols - 2, rows - 2);
+}
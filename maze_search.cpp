@@ -0,0 +1,454 @@
+#include "maze_core.h"
+#include <algorithm>
+#include <bit>
+#include <queue>
+#include <utility>
+
+// ˫start_coordend_coordάǰ顣
+// رУu˵vӦvuһΪget_tile_cost(u)
+
+std::vector<Coordinate> MazeCore::join_paths(const std::vector<uint8_t>& forward_dir,
+    const std::vector<uint8_t>& backward_dir, Coordinate meet) const {
+    // 㵽
+    std::vector<Coordinate> path = trace_path(forward_dir, meet);
+
+    // 㵽յ㣺ǰָյһ
+    Coordinate curr = meet;
+    while (true) {
+        uint8_t d = backward_dir[tile_index(curr.x, curr.y)];
+        if (d == DIR_ROOT || d == DIR_NONE) break;
+        curr = { curr.x - DIR_DX[d], curr.y - DIR_DY[d] };
+        path.push_back(curr);
+    }
+    return path;
+}
+
+void MazeCore::compute_bidirectional_bfs_path() {
+    bidirectional_bfs_path.clear();
+    const int INF = INT_MAX;
+    std::vector<int> dist[2] = { std::vector<int>(cell_count(), INF), std::vector<int>(cell_count(), INF) };
+    std::vector<uint8_t> from_dir[2] = { std::vector<uint8_t>(cell_count(), DIR_NONE), std::vector<uint8_t>(cell_count(), DIR_NONE) };
+    std::vector<Coordinate> frontier[2] = { { start_coord }, { end_coord } };
+
+    dist[0][tile_index(start_coord.x, start_coord.y)] = 0;
+    from_dir[0][tile_index(start_coord.x, start_coord.y)] = DIR_ROOT;
+    dist[1][tile_index(end_coord.x, end_coord.y)] = 0;
+    from_dir[1][tile_index(end_coord.x, end_coord.y)] = DIR_ROOT;
+
+    size_t expanded = 0;
+    int best = (start_coord == end_coord) ? 0 : INF;
+    Coordinate meet = start_coord;
+    std::vector<Coordinate> next;
+
+    // ÿչСһࣻĳ󣬸òеСͼΪ̲
+    while (best == INF && !frontier[0].empty() && !frontier[1].empty()) {
+        int side = (frontier[0].size() <= frontier[1].size()) ? 0 : 1;
+        int other = 1 - side;
+        next.clear();
+
+        for (const Coordinate& curr : frontier[side]) {
+            ++expanded;
+            int curr_dist = dist[side][tile_index(curr.x, curr.y)];
+            for (int d = 0; d < 4; ++d) {
+                Coordinate neighbor = { curr.x + DIR_DX[d], curr.y + DIR_DY[d] };
+                if (!is_valid(neighbor)) continue;
+                size_t idx = tile_index(neighbor.x, neighbor.y);
+                if (dist[side][idx] != INF) continue;
+
+                dist[side][idx] = curr_dist + 1;
+                from_dir[side][idx] = static_cast<uint8_t>(d);
+                next.push_back(neighbor);
+
+                if (dist[other][idx] != INF && dist[side][idx] + dist[other][idx] < best) {
+                    best = dist[side][idx] + dist[other][idx];
+                    meet = neighbor;
+                }
+            }
+        }
+        frontier[side].swap(next);
+    }
+
+    expanded_nodes[PathType::BIDIRECTIONAL_BFS] = expanded;
+    if (best != INF) {
+        bidirectional_bfs_path = join_paths(from_dir[0], from_dir[1], meet);
+    }
+}
+
+void MazeCore::compute_bidirectional_dijkstra_path() {
+    bidirectional_dijkstra_path.clear();
+    const int INF = INT_MAX;
+    std::vector<int> dist[2] = { std::vector<int>(cell_count(), INF), std::vector<int>(cell_count(), INF) };
+    std::vector<uint8_t> from_dir[2] = { std::vector<uint8_t>(cell_count(), DIR_NONE), std::vector<uint8_t>(cell_count(), DIR_NONE) };
+    using PriorityNode = std::pair<int, size_t>;
+    std::priority_queue<PriorityNode, std::vector<PriorityNode>, std::greater<>> pq[2];
+
+    size_t start_idx = tile_index(start_coord.x, start_coord.y);
+    size_t end_idx = tile_index(end_coord.x, end_coord.y);
+    dist[0][start_idx] = 0;
+    from_dir[0][start_idx] = DIR_ROOT;
+    pq[0].emplace(0, start_idx);
+    dist[1][end_idx] = 0;
+    from_dir[1][end_idx] = DIR_ROOT;
+    pq[1].emplace(0, end_idx);
+
+    size_t expanded = 0;
+    int best = (start_idx == end_idx) ? 0 : INF; // ѷֵյ
+    Coordinate meet = start_coord;
+
+    while (true) {
+        // ѱ̾ȡľɼ¼֤ѶΪʵСֵ
+        for (int side = 0; side < 2; ++side) {
+            while (!pq[side].empty() && pq[side].top().first > dist[side][pq[side].top().second]) {
+                pq[side].pop();
+            }
+        }
+        if (pq[0].empty() || pq[1].empty()) break;
+
+        // ֹͣѶ֮ͲСֵ֪ʱٳָ·
+        int top_forward = pq[0].top().first;
+        int top_backward = pq[1].top().first;
+        if (best != INF && top_forward + top_backward >= best) break;
+
+        int side = (top_forward <= top_backward) ? 0 : 1;
+        int other = 1 - side;
+        auto [cost, idx] = pq[side].top();
+        pq[side].pop();
+        ++expanded;
+
+        int x = static_cast<int>(idx % cols);
+        int y = static_cast<int>(idx / cols);
+        // ڸڸۣ˻ڸӦ߽ǰ񣬸ǰ
+        int backward_step = get_tile_cost(tile_at(x, y));
+        for (int d = 0; d < 4; ++d) {
+            Coordinate neighbor = { x + DIR_DX[d], y + DIR_DY[d] };
+            if (!is_valid(neighbor)) continue;
+            size_t n_idx = tile_index(neighbor.x, neighbor.y);
+            int step = (side == 0) ? get_tile_cost(tile_at(neighbor.x, neighbor.y)) : backward_step;
+            int new_cost = cost + step;
+            if (new_cost < dist[side][n_idx]) {
+                dist[side][n_idx] = new_cost;
+                from_dir[side][n_idx] = static_cast<uint8_t>(d);
+                pq[side].emplace(new_cost, n_idx);
+            }
+            if (dist[other][n_idx] != INF && dist[side][n_idx] + dist[other][n_idx] < best) {
+                best = dist[side][n_idx] + dist[other][n_idx];
+                meet = neighbor;
+            }
+        }
+    }
+
+    expanded_nodes[PathType::BIDIRECTIONAL_DIJKSTRA] = expanded;
+    if (best != INF) {
+        bidirectional_dijkstra_path = join_paths(from_dir[0], from_dir[1], meet);
+    }
+}
+
+// ---------------- λBFS ----------------
+// ͨ԰дΪ64λ֡ͨУֺ鷺Kogge-Stoneڵһͨ
+// ٰ·λͬһּ֣BFS·չÿ߽ڻݡ
+
+// openڴseedλλ䵽ͨͷ6λɿԽ֣
+static uint64_t fill_word(uint64_t seed, uint64_t open) {
+    uint64_t up = seed, up_open = open;
+    uint64_t down = seed, down_open = open;
+    for (int shift = 1; shift < 64; shift <<= 1) {
+        up |= up_open & (up << shift);
+        up_open &= up_open << shift;
+        down |= down_open & (down >> shift);
+        down_open &= down_open >> shift;
+    }
+    return up | down;
+}
+
+BitGrid MazeCore::build_passability_bits() const {
+    BitGrid open(rows, cols);
+    std::vector<uint8_t> scratch;
+    for (int y = 0; y < rows; ++y) {
+        const uint8_t* row = tile_row(y, scratch);
+        for (int w = 0; w < open.get_words_per_row(); ++w) {
+            uint64_t bits = 0;
+            int x_end = std::min(cols, (w + 1) * 64);
+            for (int x = w * 64; x < x_end; ++x) {
+                TileType type = static_cast<TileType>(static_cast<int8_t>(row[x]));
+                if (type != TileType::WALL && type != TileType::LAVA) {
+                    bits |= uint64_t(1) << (x % 64);
+                }
+            }
+            open.word(open.word_index(y, w)) = bits;
+        }
+    }
+    return open;
+}
+
+bool MazeCore::validate_bitset() const {
+    if (start_coord == end_coord) return true;
+
+    BitGrid open = build_passability_bits();
+    BitGrid visited(rows, cols);
+    BitGrid pending(rows, cols); // ִλ
+    const int words_per_row = open.get_words_per_row();
+    std::vector<size_t> worklist;
+
+    auto add_seed = [&](int y, int w, uint64_t bits) {
+        size_t idx = open.word_index(y, w);
+        bits &= open.word(idx) & ~visited.word(idx);
+        if (bits == 0) return;
+        if (pending.word(idx) == 0) worklist.push_back(idx);
+        pending.word(idx) |= bits;
+    };
+
+    add_seed(start_coord.y, start_coord.x / 64, uint64_t(1) << (start_coord.x % 64));
+    const size_t end_word = open.word_index(end_coord.y, end_coord.x / 64);
+    const uint64_t end_bit = uint64_t(1) << (end_coord.x % 64);
+
+    while (!worklist.empty()) {
+        size_t idx = worklist.back();
+        worklist.pop_back();
+        uint64_t seeds = pending.word(idx) & ~visited.word(idx);
+        pending.word(idx) = 0;
+        if (seeds == 0) continue;
+
+        uint64_t filled = fill_word(seeds, open.word(idx)) & ~visited.word(idx);
+        visited.word(idx) |= filled;
+        if (idx == end_word && (filled & end_bit)) return true;
+
+        int y = static_cast<int>(idx / words_per_row);
+        int w = static_cast<int>(idx % words_per_row);
+        if (y > 0) add_seed(y - 1, w, filled);
+        if (y < rows - 1) add_seed(y + 1, w, filled);
+        if (w > 0 && (filled & 1)) add_seed(y, w - 1, uint64_t(1) << 63);
+        if (w < words_per_row - 1 && (filled >> 63)) add_seed(y, w + 1, 1);
+    }
+    return false;
+}
+
+void MazeCore::compute_bfs_bitset() {
+    bfs_path.clear();
+
+    BitGrid open = build_passability_bits();
+    BitGrid visited(rows, cols);
+    BitGrid next(rows, cols);
+    const int words_per_row = open.get_words_per_row();
+
+    // ÿ߽Ϊ±(±, λ)б֮Ͳʹĸ
+    using FrontierWord = std::pair<size_t, uint64_t>;
+    std::vector<std::vector<FrontierWord>> levels;
+    std::vector<size_t> touched;
+
+    size_t start_word = open.word_index(start_coord.y, start_coord.x / 64);
+    uint64_t start_bit = uint64_t(1) << (start_coord.x % 64);
+    const size_t end_word = open.word_index(end_coord.y, end_coord.x / 64);
+    const uint64_t end_bit = uint64_t(1) << (end_coord.x % 64);
+    visited.word(start_word) |= start_bit;
+    levels.push_back({ { start_word, start_bit } });
+
+    auto add_bits = [&](int y, int w, uint64_t bits) {
+        size_t idx = open.word_index(y, w);
+        bits &= open.word(idx) & ~visited.word(idx);
+        if (bits == 0) return;
+        if (next.word(idx) == 0) touched.push_back(idx);
+        next.word(idx) |= bits;
+    };
+
+    size_t expanded = 0;
+    bool found = (start_word == end_word && start_bit == end_bit);
+    while (!found) {
+        touched.clear();
+        for (const auto& [idx, bits] : levels.back()) {
+            expanded += std::popcount(bits);
+            int y = static_cast<int>(idx / words_per_row);
+            int w = static_cast<int>(idx % words_per_row);
+            if (y > 0) add_bits(y - 1, w, bits);
+            if (y < rows - 1) add_bits(y + 1, w, bits);
+            add_bits(y, w, (bits << 1) | (bits >> 1));
+            if (w > 0 && (bits & 1)) add_bits(y, w - 1, uint64_t(1) << 63);
+            if (w < words_per_row - 1 && (bits >> 63)) add_bits(y, w + 1, 1);
+        }
+        if (touched.empty()) break;
+
+        std::sort(touched.begin(), touched.end());
+        std::vector<FrontierWord> level;
+        level.reserve(touched.size());
+        for (size_t idx : touched) {
+            uint64_t bits = next.word(idx);
+            next.word(idx) = 0;
+            visited.word(idx) |= bits;
+            level.emplace_back(idx, bits);
+            if (idx == end_word && (bits & end_bit)) found = true;
+        }
+        levels.push_back(std::move(level));
+    }
+    expanded_nodes[PathType::BFS] = expanded;
+
+    if (!found) {
+        bfs_path.push_back(end_coord); // ʵһ£ɴʱֻյ
+        return;
+    }
+
+    // յˣһаϡ¡˳һڸ
+    auto in_level = [&](const std::vector<FrontierWord>& level, Coordinate c) {
+        if (c.x < 0 || c.x >= cols || c.y < 0 || c.y >= rows) return false;
+        size_t idx = open.word_index(c.y, c.x / 64);
+        auto it = std::lower_bound(level.begin(), level.end(), FrontierWord{ idx, 0 });
+        return it != level.end() && it->first == idx && ((it->second >> (c.x % 64)) & 1);
+    };
+
+    Coordinate curr = end_coord;
+    bfs_path.push_back(curr);
+    for (size_t lvl = levels.size() - 1; lvl > 0; --lvl) {
+        for (int d = 0; d < 4; ++d) {
+            Coordinate prev = { curr.x + DIR_DX[d], curr.y + DIR_DY[d] };
+            if (in_level(levels[lvl - 1], prev)) {
+                curr = prev;
+                break;
+            }
+        }
+        bfs_path.push_back(curr);
+    }
+    std::reverse(bfs_path.begin(), bfs_path.end());
+}
+
+void MazeCore::compute_exit_field() {
+    // DijkstraͰУu˵vӦvuһΪget_tile_cost(u)
+    // ͼֻһΣ֮λõյ·߶ֱӶ
+    if (!solver_state_fits(sizeof(int) + sizeof(uint8_t), "Exit field")) {
+        exit_dist.clear();
+        exit_dir.clear();
+        return;
+    }
+    const int INF = INT_MAX;
+    exit_dist.assign(cell_count(), INF);
+    exit_dir.assign(cell_count(), DIR_NONE);
+
+    const int bucket_count = get_max_tile_cost() + 1;
+    std::vector<std::vector<size_t>> buckets(bucket_count);
+    size_t end_idx = tile_index(end_coord.x, end_coord.y);
+    exit_dist[end_idx] = 0;
+    exit_dir[end_idx] = DIR_ROOT;
+    buckets[0].push_back(end_idx);
+    size_t queued = 1;
+
+    for (int cost = 0; queued > 0; ++cost) {
+        std::vector<size_t>& bucket = buckets[cost % bucket_count];
+        while (!bucket.empty()) {
+            size_t idx = bucket.back();
+            bucket.pop_back();
+            --queued;
+            if (exit_dist[idx] != cost) continue; // ѱ̾ȡľɼ¼
+
+            int x = static_cast<int>(idx % cols);
+            int y = static_cast<int>(idx / cols);
+            int step_cost = get_tile_cost(tile_at(x, y));
+            for (int d = 0; d < 4; ++d) {
+                Coordinate neighbor = { x + DIR_DX[d], y + DIR_DY[d] };
+                if (!is_valid(neighbor)) continue;
+                size_t n_idx = tile_index(neighbor.x, neighbor.y);
+                int new_cost = cost + step_cost;
+                if (new_cost < exit_dist[n_idx]) {
+                    exit_dist[n_idx] = new_cost;
+                    exit_dir[n_idx] = static_cast<uint8_t>(d);
+                    buckets[new_cost % bucket_count].push_back(n_idx);
+                    ++queued;
+                }
+            }
+        }
+    }
+}
+
+bool MazeCore::has_exit_field() const { return !exit_dist.empty(); }
+
+int MazeCore::get_cost_to_exit(Coordinate from) const {
+    if (!has_exit_field() || from.x < 0 || from.x >= cols || from.y < 0 || from.y >= rows) return -1;
+    int cost = exit_dist[tile_index(from.x, from.y)];
+    return cost == INT_MAX ? -1 : cost;
+}
+
+std::vector<Coordinate> MazeCore::route_to_exit(Coordinate from) const {
+    std::vector<Coordinate> route;
+    if (get_cost_to_exit(from) < 0) return route;
+
+    Coordinate curr = from;
+    route.push_back(curr);
+    while (true) {
+        uint8_t d = exit_dir[tile_index(curr.x, curr.y)];
+        if (d == DIR_ROOT || d == DIR_NONE) break;
+        curr = { curr.x - DIR_DX[d], curr.y - DIR_DY[d] };
+        route.push_back(curr);
+    }
+    return route;
+}
+
+uint8_t MazeCore::planner_cell_cost(TileType type) const {
+    if (type == TileType::WALL || type == TileType::LAVA) return 0;
+    return static_cast<uint8_t>(get_tile_cost(type));
+}
+
+// ѹ滮ĸ±תΪ·
+static std::vector<Coordinate> planner_path(const IncrementalPlanner& planner, int cols) {
+    const std::vector<size_t>& indices = planner.get_path();
+    std::vector<Coordinate> path;
+    path.reserve(indices.size());
+    for (size_t idx : indices) {
+        path.push_back({ static_cast<int>(idx % cols), static_cast<int>(idx / cols) });
+    }
+    return path;
+}
+
+// ޸չܸ1/32Ψһͨ·ȸĶLPA*Ƭ̧ٻ䣬
+// ͼʱθͼDijkstra
+const size_t INCREMENTAL_BUDGET_DIVISOR = 32;
+
+void MazeCore::enable_incremental_planning() { incremental_planning = true; }
+
+bool MazeCore::is_incremental_planning() const { return incremental_planning; }
+
+bool MazeCore::compute_incremental_path() {
+    ReplanResult result;
+    if (!planner) {
+        // ǰ滮״
+        std::vector<uint8_t> cost(cell_count());
+        std::vector<uint8_t> scratch;
+        for (int y = 0; y < rows; ++y) {
+            const uint8_t* row = tile_row(y, scratch);
+            for (int x = 0; x < cols; ++x) {
+                cost[tile_index(x, y)] = planner_cell_cost(static_cast<TileType>(static_cast<int8_t>(row[x])));
+            }
+        }
+        planner = std::make_unique<IncrementalPlanner>(rows, cols, std::move(cost),
+            tile_index(start_coord.x, start_coord.y), tile_index(end_coord.x, end_coord.y), get_min_tile_cost());
+        result = planner->replan();
+    }
+    else {
+        result = planner->replan(std::max<size_t>(cell_count() / INCREMENTAL_BUDGET_DIVISOR, 1024));
+    }
+    expanded_nodes[PathType::DIJKSTRA] = planner->get_expanded();
+    if (result == ReplanResult::BUDGET_EXCEEDED) {
+        planner_synced = false;
+        return false;
+    }
+
+    // ·δӰdijkstra_pathǹ滮ϴθ·ʱԭãȥO(·)ת
+    if (result == ReplanResult::CHANGED || !planner_synced) {
+        dijkstra_path = planner_path(*planner, cols);
+        planner_synced = true;
+    }
+    return true;
+}
+
+void MazeCore::replan_after_edit(Coordinate c) {
+    // ·볡ϣcompute_pathҲ·ʱվɽ
+    // 滮ʱdijkstra_path޸δ··ֱ
+    for (std::vector<Coordinate>* path : { &dfs_path, &bfs_path, &astar_path,
+        &bidirectional_bfs_path, &bidirectional_dijkstra_path }) {
+        path->clear();
+    }
+    if (!planner || !planner_synced) dijkstra_path.clear();
+    computed_paths = 0;
+    exit_dist.clear();
+    exit_dir.clear();
+
+    // 滮ֻ¸Ķĸ޸´compute_path(DIJKSTRA)
+    if (planner) {
+        planner->set_cell_cost(tile_index(c.x, c.y), planner_cell_cost(tile_at(c.x, c.y)));
+    }
+}
@@ -0,0 +1,101 @@
+#include "player_sim.h"
+#include <cmath>
+
+PlayerSim::PlayerSim(const MazeCore& maze_ref) : maze(maze_ref) {
+    reset();
+}
+
+void PlayerSim::reset() {
+    curr_coor = maze.get_start_coord();
+    target_coor = curr_coor;
+    pos_x = prev_x = static_cast<float>(curr_coor.x);
+    pos_y = prev_y = static_cast<float>(curr_coor.y);
+    state = PlayerState::STANDING;
+    curr_frame = 0;
+    frame_timer = 0;
+    walk_score = 0;
+    is_win = false;
+    is_dead = false;
+    ticks = 0;
+}
+
+void PlayerSim::turn(PlayerState new_state, Coordinate target) {
+    state = new_state;
+    target_coor = target;
+    curr_frame = 0;
+    frame_timer = 0;
+}
+
+void PlayerSim::control_update(MoveInput input) {
+    if (is_win || is_dead || state != PlayerState::STANDING) return;
+
+    Coordinate target = curr_coor;
+    PlayerState new_state = PlayerState::STANDING;
+    switch (input) {
+    case MoveInput::DOWN: target.y += 1; new_state = PlayerState::DOWN; break;
+    case MoveInput::LEFT: target.x -= 1; new_state = PlayerState::LEFT; break;
+    case MoveInput::RIGHT: target.x += 1; new_state = PlayerState::RIGHT; break;
+    case MoveInput::UP: target.y -= 1; new_state = PlayerState::UP; break;
+    default: return; // NONE
+    }
+    if (maze.get_tile_type(target) != TileType::WALL) {
+        turn(new_state, target);
+    }
+}
+
+void PlayerSim::walk_update() {
+    // ֡ģʱƽ
+    frame_timer += SIM_DT;
+    if (frame_timer >= PLAYER_FRAME_TIME) {
+        frame_timer = 0;
+        curr_frame = (curr_frame + 1) % PLAYER_FRAME_COUNT;
+    }
+
+    // ÿƶPLAYER_SPEED * SIM_DTʣ벻һʱǡͣĿϣԽ
+    float dx = target_coor.x - pos_x;
+    float dy = target_coor.y - pos_y;
+    float distance = std::sqrt(dx * dx + dy * dy);
+    float step_len = PLAYER_SPEED * SIM_DT;
+    if (distance > step_len) {
+        pos_x += dx / distance * step_len;
+        pos_y += dy / distance * step_len;
+        return;
+    }
+
+    pos_x = static_cast<float>(target_coor.x);
+    pos_y = static_cast<float>(target_coor.y);
+    curr_coor = target_coor;
+    state = PlayerState::STANDING;
+
+    // /յ
+    TileType current_tile = maze.get_tile_type(curr_coor);
+    if (current_tile == TileType::LAVA) {
+        is_dead = true;
+    }
+    else {
+        walk_score += maze.get_tile_cost(current_tile);
+    }
+
+    Coordinate end_coor = maze.get_end_coord();
+    if (curr_coor.x == end_coor.x && curr_coor.y == end_coor.y) {
+        is_win = true;
+    }
+}
+
+void PlayerSim::step(MoveInput input) {
+    prev_x = pos_x;
+    prev_y = pos_y;
+    ++ticks;
+    control_update(input);
+    if (state != PlayerState::STANDING) {
+        walk_update();
+    }
+}
+
+uint64_t PlayerSim::run(const InputSource& input, uint64_t max_ticks) {
+    uint64_t start = ticks;
+    while (!is_finished() && ticks - start < max_ticks) {
+        step(input(*this));
+    }
+    return ticks - start;
+}
@@ -0,0 +1,87 @@
+#ifndef PLAYER_SIM_H
+#define PLAYER_SIM_H
+
+// ģ⣺Թ̶ƽƶ֡Ʒ֣raylib
+// ɵ÷ע룬޴ڻԶ֡ʵٶ
+#include <cstdint>
+#include <functional>
+#include "maze_core.h"
+
+// ״̬ö٣кΪȡֵ1
+enum class PlayerState {
+    STANDING,
+    DOWN,
+    LEFT,
+    RIGHT,
+    UP
+};
+
+// ÿģⲽķ
+enum class MoveInput : uint8_t {
+    NONE,
+    DOWN,
+    LEFT,
+    RIGHT,
+    UP
+};
+
+// ģⲽÿ120Ⱦ֡޹
+const int SIM_TICK_RATE = 120;
+const float SIM_DT = 1.0f / SIM_TICK_RATE;
+
+// سٶԸ/ƣؿسߴ޹أ
+const float PLAYER_SPEED = 200.0f / 48.0f;
+const float PLAYER_FRAME_TIME = 0.1f;
+const int PLAYER_FRAME_COUNT = 3;
+
+// ԴÿģⲽһΣظòķ
+class PlayerSim;
+using InputSource = std::function<MoveInput(const PlayerSim&)>;
+
+// PlayerSimҵȷģ⣬λԸΪλ
+// ͬԹͬǵõͬλá÷ʤ
+class PlayerSim {
+private:
+    const MazeCore& maze;
+    Coordinate curr_coor = { 0, 0 };
+    float pos_x = 0, pos_y = 0;       // ǰλã
+    float prev_x = 0, prev_y = 0;     // һλãƲֵ
+    Coordinate target_coor = { 0, 0 };
+    PlayerState state = PlayerState::STANDING;
+    int curr_frame = 0;
+    float frame_timer = 0;
+    int walk_score = 0;
+    bool is_win = false;
+    bool is_dead = false;
+    uint64_t ticks = 0;
+
+    void turn(PlayerState new_state, Coordinate target);
+    void control_update(MoveInput input);
+    void walk_update();
+
+public:
+    PlayerSim(const MazeCore& maze_ref);
+
+    // ƽһģⲽ
+    void step(MoveInput input);
+
+    // ƽֱʤﵽmax_ticksʵƽĲ
+    uint64_t run(const InputSource& input, uint64_t max_ticks);
+
+    void reset();
+
+    // alpha0Ϊһ1Ϊǰֵ֮λã
+    float get_x(float alpha) const { return prev_x + (pos_x - prev_x) * alpha; }
+    float get_y(float alpha) const { return prev_y + (pos_y - prev_y) * alpha; }
+
+    Coordinate get_coord() const { return curr_coor; }
+    PlayerState get_state() const { return state; }
+    int get_frame() const { return curr_frame; }
+    int get_score() const { return walk_score; }
+    bool is_win_state() const { return is_win; }
+    bool is_dead_state() const { return is_dead; }
+    bool is_finished() const { return is_win || is_dead; }
+    uint64_t get_ticks() const { return ticks; }
+};
+
+#endif // PLAYER_SIM_H
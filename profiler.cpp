@@ -0,0 +1,137 @@
+#include "maze_game.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+
+static const char* PHASE_NAMES[static_cast<int>(ProfilePhase::COUNT)] = {
+    "update", "player_update", "maze_draw", "player_draw", "hud", "profiler", "end_drawing"
+};
+
+// ֶϸеɫ
+static const Color PHASE_COLORS[static_cast<int>(ProfilePhase::COUNT)] = {
+    Color{ 120, 120, 255, 255 }, Color{ 0, 200, 255, 255 }, Color{ 0, 220, 0, 255 },
+    Color{ 255, 200, 0, 255 }, Color{ 255, 120, 0, 255 }, Color{ 200, 120, 255, 255 },
+    Color{ 220, 60, 60, 255 }
+};
+
+FrameProfiler::FrameProfiler() {
+    clock.start();
+}
+
+const FrameProfiler::FrameRecord& FrameProfiler::frame_at(int age) const {
+    return frames[(head - 1 - age + PROFILE_FRAMES) % PROFILE_FRAMES];
+}
+
+void FrameProfiler::begin_frame() {
+    FrameRecord& frame = frames[head];
+    frame.start_ns = clock.get_elapsed_ns();
+    frame.frame_ns = 0;
+    for (int i = 0; i < static_cast<int>(ProfilePhase::COUNT); ++i) {
+        frame.phase_start_ns[i] = frame.start_ns;
+        frame.phase_ns[i] = 0;
+    }
+}
+
+void FrameProfiler::end_frame() {
+    FrameRecord& frame = frames[head];
+    frame.frame_ns = clock.get_elapsed_ns() - frame.start_ns;
+    head = (head + 1) % PROFILE_FRAMES;
+    count = std::min(count + 1, PROFILE_FRAMES);
+}
+
+void FrameProfiler::begin_phase(ProfilePhase phase) {
+    frames[head].phase_start_ns[static_cast<int>(phase)] = clock.get_elapsed_ns();
+}
+
+void FrameProfiler::end_phase(ProfilePhase phase) {
+    FrameRecord& frame = frames[head];
+    int i = static_cast<int>(phase);
+    frame.phase_ns[i] += clock.get_elapsed_ns() - frame.phase_start_ns[i];
+}
+
+void FrameProfiler::draw_overlay(int x, int y) const {
+    const int graph_width = PROFILE_FRAMES;
+    const int graph_height = 100;
+    const float ms_per_pixel = 33.3f / graph_height; // ԼΪ30FPS֡ʱ
+    const int panel_height = graph_height + 30 + 22 * static_cast<int>(ProfilePhase::COUNT);
+    DrawRectangle(x, y, graph_width + 220, panel_height, Color{ 0, 0, 0, 180 });
+
+    // ֡ʱߣÿ֡һУֶεɫΪ16.7ms60FPS
+    int base_y = y + 10 + graph_height;
+    for (int age = 0; age < count; ++age) {
+        const FrameRecord& frame = frame_at(age);
+        int col = x + 10 + graph_width - 1 - age;
+        float top = static_cast<float>(base_y);
+        for (int i = 0; i < static_cast<int>(ProfilePhase::COUNT); ++i) {
+            if (static_cast<ProfilePhase>(i) == ProfilePhase::PLAYER_UPDATE) continue; // ѺUPDATE
+            float h = std::min(frame.phase_ns[i] / 1e6f / ms_per_pixel, top - (base_y - graph_height));
+            DrawRectangle(col, static_cast<int>(top - h), 1, static_cast<int>(h + 0.5f), PHASE_COLORS[i]);
+            top -= h;
+        }
+        float total = std::min(frame.frame_ns / 1e6f / ms_per_pixel, static_cast<float>(graph_height));
+        DrawRectangle(col, base_y - static_cast<int>(total), 1, 1, LIGHTGRAY);
+    }
+    int line_y = base_y - static_cast<int>(16.7f / ms_per_pixel);
+    DrawRectangle(x + 10, line_y, graph_width, 1, WHITE);
+
+    // ֶϸƽֵһ֡дջϻ壬ѷ
+    char text[96];
+    double avg_frame = 0;
+    for (int age = 0; age < count; ++age) avg_frame += frame_at(age).frame_ns;
+    avg_frame = count > 0 ? avg_frame / count / 1e6 : 0.0;
+    std::snprintf(text, sizeof(text), "frame avg %.2fms last %.2fms",
+        avg_frame, count > 0 ? frame_at(0).frame_ns / 1e6 : 0.0);
+    DrawText(text, x + 10, base_y + 8, 20, WHITE);
+
+    for (int i = 0; i < static_cast<int>(ProfilePhase::COUNT); ++i) {
+        double avg = 0;
+        for (int age = 0; age < count; ++age) avg += frame_at(age).phase_ns[i];
+        avg = count > 0 ? avg / count / 1e6 : 0.0;
+        std::snprintf(text, sizeof(text), "%-14s avg %.2fms last %.2fms",
+            PHASE_NAMES[i], avg, count > 0 ? frame_at(0).phase_ns[i] / 1e6 : 0.0);
+        DrawText(text, x + 10, base_y + 30 + 22 * i, 20, PHASE_COLORS[i]);
+    }
+}
+
+bool FrameProfiler::export_csv(const std::string& filepath) const {
+    std::ofstream file(filepath);
+    if (!file.is_open()) return false;
+
+    // ̶λС΢뾫ȣĬ6λЧڳʱк뵽ÿѧ
+    file << std::fixed << std::setprecision(3);
+    file << "frame,start_ms,frame_ms";
+    for (const char* name : PHASE_NAMES) file << "," << name << "_ms";
+    file << "\n";
+    for (int age = count - 1; age >= 0; --age) {
+        const FrameRecord& frame = frame_at(age);
+        file << (count - 1 - age) << "," << frame.start_ns / 1e6 << "," << frame.frame_ns / 1e6;
+        for (int i = 0; i < static_cast<int>(ProfilePhase::COUNT); ++i) file << "," << frame.phase_ns[i] / 1e6;
+        file << "\n";
+    }
+    return static_cast<bool>(file);
+}
+
+bool FrameProfiler::export_chrome_trace(const std::string& filepath) const {
+    std::ofstream file(filepath);
+    if (!file.is_open()) return false;
+
+    // ÿֶ֡д¼"ph":"X"ʱ䵥λΪ΢룬루̶Сʱȣ
+    file << std::fixed << std::setprecision(3);
+    file << "{\"traceEvents\":[\n";
+    bool first = true;
+    auto write_event = [&file, &first](const char* name, int64_t start_ns, int64_t dur_ns) {
+        file << (first ? "" : ",\n") << "{\"name\":\"" << name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":"
+            << start_ns / 1000.0 << ",\"dur\":" << dur_ns / 1000.0 << "}";
+        first = false;
+    };
+    for (int age = count - 1; age >= 0; --age) {
+        const FrameRecord& frame = frame_at(age);
+        write_event("frame", frame.start_ns, frame.frame_ns);
+        for (int i = 0; i < static_cast<int>(ProfilePhase::COUNT); ++i) {
+            if (frame.phase_ns[i] > 0) write_event(PHASE_NAMES[i], frame.phase_start_ns[i], frame.phase_ns[i]);
+        }
+    }
+    file << "\n]}\n";
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,136 @@
+#include "replay.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+MazeCore ReplayLog::build_maze() const {
+    if (!maze_file.empty()) return MazeCore(maze_file);
+    return MazeCore(rows, cols, seed);
+}
+
+void InputRecorder::record(uint64_t tick, MoveInput input) {
+    if (!events.empty() && input == last && tick - events.back().tick < REPLAY_MAX_GAP) return;
+    events.push_back({ tick, input });
+    last = input;
+}
+
+void InputRecorder::clear() {
+    events.clear();
+    last = MoveInput::NONE;
+}
+
+const std::vector<InputEvent>& InputRecorder::get_events() const { return events; }
+
+ReplayResult sim_result(const PlayerSim& sim) {
+    ReplayResult result;
+    result.ticks = sim.get_ticks();
+    result.score = sim.get_score();
+    result.win = sim.is_win_state();
+    result.dead = sim.is_dead_state();
+    return result;
+}
+
+InputSource replay_input(const std::vector<InputEvent>& events) {
+    return [&events, next = size_t(0), current = MoveInput::NONE](const PlayerSim& sim) mutable {
+        while (next < events.size() && events[next].tick <= sim.get_ticks()) {
+            current = events[next++].input;
+        }
+        return current;
+    };
+}
+
+uint64_t replay_tick_limit(const ReplayLog& log) {
+    return (log.events.empty() ? 0 : log.events.back().tick) + REPLAY_MAX_GAP;
+}
+
+ReplayResult run_replay(const MazeCore& maze, const ReplayLog& log) {
+    PlayerSim sim(maze);
+    sim.run(replay_input(log.events), std::min(log.result.ticks, replay_tick_limit(log)));
+    return sim_result(sim);
+}
+
+bool save_replay(const ReplayLog& log, const std::string& filepath) {
+    std::ofstream file(filepath);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open replay file!" << std::endl;
+        return false;
+    }
+
+    file << "MZRP 2\n";
+    if (!log.maze_file.empty()) file << "file " << log.maze_file << "\n";
+    else file << "random " << log.rows << " " << log.cols << " " << log.seed << "\n";
+    file << "result " << log.result.ticks << " " << log.result.score << " "
+        << log.result.win << " " << log.result.dead << "\n";
+    file << "events " << log.events.size() << "\n";
+    for (const InputEvent& e : log.events) {
+        file << e.tick << " " << static_cast<int>(e.input) << "\n";
+    }
+    return static_cast<bool>(file);
+}
+
+bool load_replay(const std::string& filepath, ReplayLog& log) {
+    std::ifstream file(filepath);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open replay file!" << std::endl;
+        return false;
+    }
+
+    std::string magic, source;
+    int version = 0;
+    file >> magic >> version >> source;
+    if (magic != "MZRP" || version != 2) {
+        std::cerr << "Invalid replay file: " << filepath << std::endl;
+        return false;
+    }
+
+    log = ReplayLog{};
+    if (source == "file") {
+        file >> std::ws;
+        std::getline(file, log.maze_file); // ·ܺո񣬶β
+    }
+    else if (source == "random") {
+        file >> log.rows >> log.cols >> log.seed;
+    }
+    else {
+        std::cerr << "Invalid replay file: " << filepath << std::endl;
+        return false;
+    }
+
+    std::string tag;
+    size_t count = 0;
+    file >> tag >> log.result.ticks >> log.result.score >> log.result.win >> log.result.dead;
+    if (tag != "result") return false;
+    file >> tag >> count;
+    if (tag != "events" || !file) return false;
+
+    // ÿ¼ռ4ֽڣ"0 0\n"¼óʣֽɵģⰴαڴ
+    const size_t MIN_EVENT_BYTES = 4;
+    std::streampos pos = file.tellg();
+    file.seekg(0, std::ios::end);
+    std::streamoff remaining = file.tellg() - pos;
+    file.seekg(pos);
+    if (remaining < 0 || count > static_cast<size_t>(remaining) / MIN_EVENT_BYTES + 1) {
+        std::cerr << "Invalid replay file: " << filepath << std::endl;
+        return false;
+    }
+
+    log.events.resize(count);
+    uint64_t prev_tick = 0;
+    for (InputEvent& e : log.events) {
+        int input = 0;
+        file >> e.tick >> input;
+        if (input < 0 || input > static_cast<int>(MoveInput::UP) || e.tick < prev_tick) return false;
+        e.input = static_cast<MoveInput>(input);
+        prev_tick = e.tick;
+    }
+    if (!file) {
+        std::cerr << "Replay file truncated: " << filepath << std::endl;
+        return false;
+    }
+    if (log.result.ticks > replay_tick_limit(log)) {
+        std::cerr << "Invalid replay file: " << filepath << std::endl;
+        return false;
+    }
+    return true;
+}
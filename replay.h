@@ -0,0 +1,77 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+// Ծ¼񣺼¼ԹԴļߴ+ӣ밴ģⲽǵķ룬
+// ޴ڻȫٻطţֵ÷֡ʤʱ
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "maze_core.h"
+#include "player_sim.h"
+
+// 仯¼ӵtickΪinputֻ¼仯סֻռһ
+struct InputEvent {
+    uint64_t tick;
+    MoveInput input;
+};
+
+// Ծֽطʱȶԣ
+struct ReplayResult {
+    uint64_t ticks = 0;
+    int score = 0;
+    bool win = false;
+    bool dead = false;
+
+    bool operator==(const ReplayResult& other) const = default;
+
+    // Ϸʱ룩ģⲽ㣬֡޹
+    double game_time() const { return static_cast<double>(ticks) / SIM_TICK_RATE; }
+};
+
+// ¼
+struct ReplayLog {
+    std::string maze_file;  // ǿʱӸļԹ
+    int rows = 0;           // maze_fileΪʱߴ
+    int cols = 0;
+    uint32_t seed = 0;
+    std::vector<InputEvent> events;
+    ReplayResult result;    // ¼ʱĽ
+
+    // ¼ԴԹ
+    MazeCore build_maze() const;
+};
+
+// ͬһٲ¼ʱһͬ룬ʹ¼ܲ
+// һ¼ĲӴֵȡʱݴ˾ܾƲ¼
+const uint64_t REPLAY_MAX_GAP = SIM_TICK_RATE;
+
+// InputRecorder𲽼¼룬ֻ仯ͬһREPLAY_MAX_GAPʱ׷¼
+class InputRecorder {
+private:
+    std::vector<InputEvent> events;
+    MoveInput last = MoveInput::NONE;
+
+public:
+    void record(uint64_t tick, MoveInput input);
+    void clear();
+    const std::vector<InputEvent>& get_events() const;
+};
+
+// ȡģ⵱ǰĽ
+ReplayResult sim_result(const PlayerSim& sim);
+
+// طõԴǰЧ¼ֻ˳ƽɣ
+InputSource replay_input(const std::vector<InputEvent>& events);
+
+// ¼ɻطŵһ¼ĲREPLAY_MAX_GAP
+uint64_t replay_tick_limit(const ReplayLog& log);
+
+// mazeϻط¼񣬷ػطŽ¼ƵܲΪޣҲreplay_tick_limit
+ReplayResult run_replay(const MazeCore& maze, const ReplayLog& log);
+
+// ¼ļдıʽ"MZRP 2"¼ļʣֽɵġ
+// ܲreplay_tick_limit¼ΪЧ
+bool save_replay(const ReplayLog& log, const std::string& filepath);
+bool load_replay(const std::string& filepath, ReplayLog& log);
+
+#endif // REPLAY_H
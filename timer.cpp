@@ -1,33 +1,35 @@
 #include "maze_game.h"
 
-Timer::Timer() : is_running(false), elapsed_time(0.0f) {}
+Timer::Timer() : is_running(false), elapsed_ns(0) {}
 
 void Timer::start() {
     if (!is_running) {
-        start_time = std::chrono::high_resolution_clock::now();
+        start_time = std::chrono::steady_clock::now();
         is_running = true;
     }
 }
 
 void Timer::stop() {
     if (is_running) {
-        auto end_time = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<float> duration = end_time - start_time;
-        elapsed_time += duration.count();
+        auto end_time = std::chrono::steady_clock::now();
+        elapsed_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count();
         is_running = false;
     }
 }
 
 void Timer::reset() {
-    elapsed_time = 0.0f;
+    elapsed_ns = 0;
     is_running = false;
 }
 
-float Timer::get_elapsed_time() const {
+int64_t Timer::get_elapsed_ns() const {
     if (is_running) {
-        auto current_time = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<float> duration = current_time - start_time;
-        return elapsed_time + duration.count();
+        auto current_time = std::chrono::steady_clock::now();
+        return elapsed_ns + std::chrono::duration_cast<std::chrono::nanoseconds>(current_time - start_time).count();
     }
-    return elapsed_time;
-}
\ No newline at end of file
+    return elapsed_ns;
+}
+
+float Timer::get_elapsed_time() const {
+    return static_cast<float>(get_elapsed_ns() / 1e9);
+}